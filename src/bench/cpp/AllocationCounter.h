@@ -0,0 +1,65 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AllocationCounter.h
+ *
+ * Replaces the global operator new/delete to keep a count of live heap bytes
+ * and of allocations made.
+ * Include from exactly one translation unit of a standalone benchmark.
+ */
+
+#ifndef EZBAKE_BENCH_ALLOCATIONCOUNTER_H_
+#define EZBAKE_BENCH_ALLOCATIONCOUNTER_H_
+
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace ezbake { namespace bench {
+
+inline size_t& allocatedBytes() {
+    static size_t bytes = 0;
+    return bytes;
+}
+
+inline size_t& allocationCount() {
+    static size_t count = 0;
+    return count;
+}
+
+}} // namespace ezbake::bench
+
+/*
+ * Account for every heap block by its usable size. Kept out of line so the
+ * compiler does not pair the malloc/free below with inlined new/delete calls.
+ */
+__attribute__((noinline)) void* operator new(size_t size) {
+    void* ptr = std::malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    ezbake::bench::allocatedBytes() += malloc_usable_size(ptr);
+    ++ezbake::bench::allocationCount();
+    return ptr;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) throw() {
+    if (ptr) {
+        ezbake::bench::allocatedBytes() -= malloc_usable_size(ptr);
+        std::free(ptr);
+    }
+}
+
+#endif /* EZBAKE_BENCH_ALLOCATIONCOUNTER_H_ */
@@ -0,0 +1,59 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CacheEntryMemoryBench.cpp
+ *
+ * Reports the heap bytes used per entry of an LRUTimedCache. Standalone program,
+ * not part of the unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/lrucache/CacheEntryMemoryBench.cpp -o cache-entry-memory-bench
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <ezbake/common/lrucache/LRUTimedCache.h>
+#include "../AllocationCounter.h"
+
+using namespace ezbake::common::lrucache;
+
+template <typename V>
+void report(const char* name, const V& value, unsigned int entries) {
+    size_t before = ezbake::bench::allocatedBytes();
+    {
+        LRUTimedCache<uint64_t, V> cache(entries);
+        size_t empty = ezbake::bench::allocatedBytes();
+        for (unsigned int i = 0; i < entries; ++i) {
+            cache.put(i, value);
+        }
+        size_t used = ezbake::bench::allocatedBytes() - empty;
+        std::printf("%-24s sizeof(CacheValue)=%3zu  heap bytes/entry=%6.1f  (%u entries)\n",
+                    name, sizeof(CacheValue<V>), static_cast<double>(used) / entries, entries);
+    }
+    if (ezbake::bench::allocatedBytes() != before) {
+        std::printf("  leaked %zu bytes\n", ezbake::bench::allocatedBytes() - before);
+    }
+}
+
+int main(int argc, char** argv) {
+    unsigned int entries = (argc > 1) ? static_cast<unsigned int>(std::atoi(argv[1])) : 1000000;
+
+    report<uint32_t>("uint32_t", 1, entries);
+    report<uint64_t>("uint64_t", 1, entries);
+    report<void*>("void*", NULL, entries);
+    report<std::string>("std::string (short)", std::string("value"), entries);
+    return 0;
+}
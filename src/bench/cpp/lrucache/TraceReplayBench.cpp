@@ -0,0 +1,188 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * TraceReplayBench.cpp
+ *
+ * Replays a recorded access trace through LRUTimedCache on a ManualClock, so a
+ * day of traffic runs at full CPU speed, and reports hit ratio, memory and
+ * expiry counts for each candidate configuration. Standalone program, not part
+ * of the unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/lrucache/TraceReplayBench.cpp -o trace-replay-bench
+ *
+ * Usage:
+ *
+ *   trace-replay-bench <trace file | -> <capacity>:<expiration>[:<jitter>] ...
+ *
+ * Each trace line holds "<timestamp in seconds> <key>". Timestamps must not be
+ * negative and must not decrease from one line to the next; a trace that breaks
+ * this is rejected. Every lookup that misses is followed by a put of the key, as
+ * a read-through cache would do.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <ezbake/common/lrucache/LRUTimedCache.h>
+#include "../AllocationCounter.h"
+
+using namespace ezbake::common::lrucache;
+
+namespace {
+
+struct TraceRecord {
+    uint64_t timestamp;
+    std::string key;
+};
+
+struct Configuration {
+    unsigned int capacity;
+    uint64_t expiration;
+    uint64_t jitter;
+};
+
+typedef LRUTimedCache<std::string, uint32_t, ManualClock> ReplayCache;
+
+
+bool parseConfiguration(const std::string& arg, Configuration& config) {
+    unsigned long long capacity = 0, expiration = 0, jitter = 0;
+    int fields = std::sscanf(arg.c_str(), "%llu:%llu:%llu", &capacity, &expiration, &jitter);
+    if (fields < 2) {
+        return false;
+    }
+    config.capacity = static_cast<unsigned int>(capacity);
+    config.expiration = expiration;
+    config.jitter = jitter;
+    return true;
+}
+
+
+bool loadTrace(std::istream& in, std::vector<TraceRecord>& trace) {
+    TraceRecord record;
+    double timestamp;
+    while (in >> timestamp >> record.key) {
+        /*
+         * Replay rebases time on the first record, so an earlier timestamp
+         * would wrap around and expire the whole cache
+         */
+        if (timestamp < 0 || (!trace.empty() && static_cast<uint64_t>(timestamp) < trace.back().timestamp)) {
+            std::cerr << "timestamp out of order on line " << (trace.size() + 1) << ": "
+                      << std::fixed << timestamp << std::endl;
+            return false;
+        }
+        record.timestamp = static_cast<uint64_t>(timestamp);
+        trace.push_back(record);
+    }
+    return in.eof();
+}
+
+
+void replay(const std::vector<TraceRecord>& trace, const Configuration& config) {
+    uint64_t hits = 0, expirations = 0, evictions = 0;
+    size_t peakBytes = 0, baseBytes = ezbake::bench::allocatedBytes();
+    unsigned int peakEntries = 0;
+    std::clock_t start = std::clock();
+
+    {
+        ReplayCache cache(config.capacity, config.expiration);
+        cache.setRandomSeed(1);
+        cache.setExpirationJitter(config.jitter);
+
+        //rebase the trace so relative deadlines start at the cache epoch
+        uint64_t origin = trace.empty() ? 0 : trace.front().timestamp;
+
+        for (std::vector<TraceRecord>::const_iterator itr = trace.begin(); itr != trace.end(); ++itr) {
+            cache.clock().set(itr->timestamp - origin);
+
+            bool cached = cache.containsKey(itr->key);
+            if (cache.get(itr->key)) {
+                ++hits;
+                continue;
+            }
+
+            if (cached) {
+                ++expirations;
+            } else if (cache.isFull()) {
+                ++evictions;
+            }
+            cache.put(itr->key, 0);
+
+            peakEntries = std::max(peakEntries, cache.size());
+            peakBytes = std::max(peakBytes, ezbake::bench::allocatedBytes() - baseBytes);
+        }
+    }
+
+    double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    double ratio = trace.empty() ? 0.0 : static_cast<double>(hits) / trace.size();
+    std::printf("%10u %10llu %8llu %9.4f %12llu %10llu %12u %14zu %9.2f\n",
+                config.capacity,
+                static_cast<unsigned long long>(config.expiration),
+                static_cast<unsigned long long>(config.jitter),
+                ratio,
+                static_cast<unsigned long long>(expirations),
+                static_cast<unsigned long long>(evictions),
+                peakEntries,
+                peakBytes,
+                seconds);
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0]
+                  << " <trace file | -> <capacity>:<expiration>[:<jitter>] ..." << std::endl;
+        return 1;
+    }
+
+    std::vector<Configuration> configs;
+    for (int i = 2; i < argc; ++i) {
+        Configuration config;
+        if (!parseConfiguration(argv[i], config)) {
+            std::cerr << "invalid configuration: " << argv[i] << std::endl;
+            return 1;
+        }
+        configs.push_back(config);
+    }
+
+    std::vector<TraceRecord> trace;
+    std::string path(argv[1]);
+    bool loaded;
+    if (path == "-") {
+        loaded = loadTrace(std::cin, trace);
+    } else {
+        std::ifstream file(path.c_str());
+        loaded = file && loadTrace(file, trace);
+    }
+    if (!loaded) {
+        std::cerr << "unable to read trace: " << path << std::endl;
+        return 1;
+    }
+
+    std::printf("replaying %zu requests\n", trace.size());
+    std::printf("%10s %10s %8s %9s %12s %10s %12s %14s %9s\n",
+                "capacity", "expiration", "jitter", "hit ratio", "expirations",
+                "evictions", "peak entries", "peak heap bytes", "cpu secs");
+    for (std::vector<Configuration>::const_iterator itr = configs.begin(); itr != configs.end(); ++itr) {
+        replay(trace, *itr);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64Bench.cpp
+ *
+ * Compares Base64 encoding and decoding through the OpenSSL BIO chain that
+ * Base64Util used to build, EVP_EncodeBlock/EVP_DecodeBlock, and each kernel
+ * this CPU supports, for short identifiers and megabyte blobs. Also compares
+ * a Base64Util call per identifier against the batch API. Standalone program,
+ * not part of the unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/security/Base64Bench.cpp src/main/cpp/security/Base64Kernel.cpp \
+ *       src/main/cpp/security/Base64Util.cpp -lcrypto -o base64-bench
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <openssl/bio.h>
+#include <openssl/buffer.h>
+#include <openssl/evp.h>
+#include <ezbake/common/security/Base64Util.h>
+#include "../../../main/cpp/security/Base64Kernel.h"
+
+using namespace ezbake::common::security;
+
+namespace {
+
+const char* ISA_NAMES[] = { "scalar", "ssse3", "avx2", "avx512 vbmi" };
+
+size_t encodeBio(const unsigned char* in, size_t length, char* out) {
+    BIO* b64 = BIO_new(BIO_f_base64());
+    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
+    BIO* mem = BIO_new(BIO_s_mem());
+    b64 = BIO_push(b64, mem);
+    BIO_write(b64, in, static_cast<int>(length));
+    (void)BIO_flush(b64);
+    BUF_MEM* buffer;
+    BIO_get_mem_ptr(b64, &buffer);
+    std::string copy(buffer->data, buffer->length);
+    memcpy(out, copy.data(), copy.length());
+    BIO_free_all(b64);
+    return copy.length();
+}
+
+
+void report(const char* name, size_t bytes, size_t repeat, std::clock_t start) {
+    double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    std::printf("  %-20s %12.1f ns/call %10.2f GB/s\n", name, 1e9 * seconds / repeat,
+                static_cast<double>(bytes) * repeat / seconds / 1e9);
+}
+
+
+void run(size_t length, size_t repeat) {
+    std::vector<unsigned char> data(length);
+    for (size_t i = 0; i < length; ++i) {
+        data[i] = static_cast<unsigned char>(std::rand());
+    }
+    size_t whole = length - (length % 3);
+    std::vector<char> encoded(base64kernel::encodedLength(length) + 1);
+    std::vector<unsigned char> decoded(length + 3);
+    std::printf("%zu bytes\n", length);
+
+    std::clock_t start = std::clock();
+    for (size_t i = 0; i < repeat; ++i) {
+        encodeBio(&data[0], length, &encoded[0]);
+    }
+    report("encode bio", length, repeat, start);
+
+    start = std::clock();
+    for (size_t i = 0; i < repeat; ++i) {
+        EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), &data[0], static_cast<int>(length));
+    }
+    report("encode evp", length, repeat, start);
+
+    for (int isa = base64kernel::SCALAR; isa <= base64kernel::bestIsa(); ++isa) {
+        start = std::clock();
+        for (size_t i = 0; i < repeat; ++i) {
+            size_t written = base64kernel::encodeTriplets(&data[0], whole, &encoded[0], base64kernel::Isa(isa));
+            base64kernel::encodeRemainder(&data[whole], length - whole, &encoded[written]);
+        }
+        report((std::string("encode ") + ISA_NAMES[isa]).c_str(), length, repeat, start);
+    }
+
+    start = std::clock();
+    for (size_t i = 0; i < repeat; ++i) {
+        EVP_DecodeBlock(&decoded[0], reinterpret_cast<const unsigned char*>(&encoded[0]),
+                        static_cast<int>(encoded.size() - 1));
+    }
+    report("decode evp", length, repeat, start);
+
+    for (int isa = base64kernel::SCALAR; isa <= base64kernel::bestIsa(); ++isa) {
+        start = std::clock();
+        for (size_t i = 0; i < repeat; ++i) {
+            bool padded = false;
+            base64kernel::decodeQuartets(&encoded[0], encoded.size() - 1, &decoded[0], padded, base64kernel::Isa(isa));
+        }
+        report((std::string("decode ") + ISA_NAMES[isa]).c_str(), length, repeat, start);
+    }
+}
+
+
+void runBatch(size_t count, size_t repeat) {
+    std::vector<std::string> data(count);
+    for (size_t i = 0; i < count; ++i) {
+        data[i].resize(16 + std::rand() % 49);
+        for (size_t j = 0; j < data[i].size(); ++j) {
+            data[i][j] = static_cast<char>(std::rand());
+        }
+    }
+    std::vector<boost::string_ref> items(data.begin(), data.end());
+    std::vector<Base64Util::Span> spans(count);
+    std::vector<std::string> encoded(count);
+    std::string arena;
+    std::printf("%zu identifiers of 16 to 64 bytes\n", count);
+
+    std::clock_t start = std::clock();
+    for (size_t r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            encoded[i] = Base64Util::encode(data[i]);
+        }
+    }
+    report("encode per item", 40 * count, repeat, start);
+
+    start = std::clock();
+    for (size_t r = 0; r < repeat; ++r) {
+        arena.clear();
+        Base64Util::encodeBatch(&items[0], count, arena, &spans[0]);
+    }
+    report("encode batch", 40 * count, repeat, start);
+
+    std::vector<boost::string_ref> texts(encoded.begin(), encoded.end());
+    start = std::clock();
+    for (size_t r = 0; r < repeat; ++r) {
+        for (size_t i = 0; i < count; ++i) {
+            data[i] = Base64Util::decode(encoded[i]);
+        }
+    }
+    report("decode per item", 40 * count, repeat, start);
+
+    start = std::clock();
+    for (size_t r = 0; r < repeat; ++r) {
+        arena.clear();
+        Base64Util::decodeBatch(&texts[0], count, arena, &spans[0]);
+    }
+    report("decode batch", 40 * count, repeat, start);
+}
+
+} // namespace
+
+
+int main() {
+    run(20, 1000000);
+    run(1 << 20, 200);
+    runBatch(100000, 50);
+    return 0;
+}
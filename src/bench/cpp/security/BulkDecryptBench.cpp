@@ -0,0 +1,72 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * BulkDecryptBench.cpp
+ *
+ * Compares decrypting PBE-MD5-DES values one at a time with the batched
+ * decryption engine. Standalone program, not part of the unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/security/BulkDecryptBench.cpp src/main/cpp/security/*.cpp \
+ *       src/main/cpp/utils/ThreadPool.cpp -lcrypto -lpthread -o bulk-decrypt-bench
+ *
+ * Usage:
+ *
+ *   bulk-decrypt-bench [values] [value length]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
+
+using namespace ezbake::common::security;
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 200000;
+    size_t length = argc > 2 ? std::strtoul(argv[2], NULL, 10) : 40;
+
+    PbeMd5AndDesEncryptor::PbeMd5AndDesKey key =
+            PbeMd5AndDesEncryptor::generateKey("bench password", "bench salt", 1000);
+
+    std::vector<std::string> encrypted(count);
+    for (size_t i = 0; i < count; ++i) {
+        encrypted[i] = PbeMd5AndDesEncryptor::encrypt(std::string(length, static_cast<char>('a' + i % 26)), key);
+    }
+
+    std::vector<std::string> single(count), batch(count);
+    std::clock_t start = std::clock();
+    for (size_t i = 0; i < count; ++i) {
+        single[i] = PbeMd5AndDesEncryptor::decrypt(encrypted[i], key);
+    }
+    double singleSeconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+
+    start = std::clock();
+    BatchErrors errors = PbeMd5AndDesEncryptor::decryptBatch(&encrypted[0], &batch[0], count, key);
+    double batchSeconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+
+    std::printf("decrypting %zu values of %zu bytes\n", count, length);
+    std::printf("%-10s %10s %14s\n", "path", "cpu secs", "values/sec");
+    std::printf("%-10s %10.3f %14.0f\n", "single", singleSeconds, count / singleSeconds);
+    std::printf("%-10s %10.3f %14.0f\n", "batch", batchSeconds, count / batchSeconds);
+
+    if (!errors.empty() || single != batch) {
+        std::fprintf(stderr, "batch output mismatch\n");
+        return 1;
+    }
+    return 0;
+}
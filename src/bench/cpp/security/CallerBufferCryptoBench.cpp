@@ -0,0 +1,90 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CallerBufferCryptoBench.cpp
+ *
+ * Reports the C++ heap allocations and time per call of the std::string and
+ * caller buffer TextCryptoProvider APIs. Standalone program, not part of the
+ * unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/security/CallerBufferCryptoBench.cpp src/main/cpp/security/*.cpp \
+ *       src/main/cpp/utils/ThreadPool.cpp -lcrypto -lpthread -o caller-buffer-crypto-bench
+ *
+ * Allocations made inside OpenSSL go through malloc and are not counted.
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <ezbake/common/security/AesGcmTextCryptoProvider.h>
+#include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
+#include "../AllocationCounter.h"
+
+using namespace ezbake::common::security;
+
+namespace {
+
+const size_t CALLS = 100000;
+
+void report(const char* name, size_t allocations, std::clock_t start) {
+    double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    std::printf("%-36s %14.2f %12.0f\n", name, static_cast<double>(allocations) / CALLS, 1e9 * seconds / CALLS);
+}
+
+
+void run(const char* name, const TextCryptoProvider& provider, const std::string& message) {
+    std::string encrypted = provider.encrypt(message);
+    std::vector<char> buffer(provider.maxEncryptedSize(message.size()) + provider.maxDecryptedSize(encrypted.size()));
+    std::string out;
+    out.reserve(buffer.size());
+    std::printf("%s\n", name);
+
+    size_t before = ezbake::bench::allocationCount();
+    std::clock_t start = std::clock();
+    for (size_t i = 0; i < CALLS; ++i) {
+        provider.decrypt(provider.encrypt(message));
+    }
+    report("  encrypt + decrypt (std::string)", ezbake::bench::allocationCount() - before, start);
+
+    before = ezbake::bench::allocationCount();
+    start = std::clock();
+    for (size_t i = 0; i < CALLS; ++i) {
+        size_t length = provider.encryptTo(message, &buffer[0], buffer.size());
+        provider.decryptTo(boost::string_ref(&buffer[0], length), &buffer[length], buffer.size() - length);
+    }
+    report("  encryptTo + decryptTo", ezbake::bench::allocationCount() - before, start);
+
+    before = ezbake::bench::allocationCount();
+    start = std::clock();
+    for (size_t i = 0; i < CALLS; ++i) {
+        out.clear();
+        provider.appendEncrypted(message, out);
+        provider.appendDecrypted(encrypted, out);
+    }
+    report("  appendEncrypted + appendDecrypted", ezbake::bench::allocationCount() - before, start);
+}
+
+} // namespace
+
+
+int main() {
+    std::string message(64, 'x');
+    std::printf("%-36s %14s %12s\n", "", "allocs/call", "ns/call");
+    run("SharedSecretTextCryptoProvider", SharedSecretTextCryptoProvider("swordfish"), message);
+    run("AesGcmTextCryptoProvider", AesGcmTextCryptoProvider("swordfish"), message);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * KeyDerivationBench.cpp
+ *
+ * Compares the MD5 iteration step of PBE key derivation through the generic
+ * EVP interface, the scalar 16 byte kernel and the multi-buffer kernel.
+ * Standalone program, not part of the unit test build:
+ *
+ *   g++ -O2 -std=c++0x -I src/main/cpp/include \
+ *       src/bench/cpp/security/KeyDerivationBench.cpp src/main/cpp/security/Md5Kernel.cpp \
+ *       -lcrypto -o key-derivation-bench
+ *
+ * Usage:
+ *
+ *   key-derivation-bench [keys] [iterations]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <openssl/evp.h>
+#include "../../../main/cpp/security/Md5Kernel.h"
+
+using namespace ezbake::common::security;
+
+namespace {
+
+typedef unsigned char Digest[md5kernel::DIGEST_LENGTH];
+
+
+void iterateEvp(Digest* digests, size_t count, long rounds) {
+    EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+    for (size_t i = 0; i < count; ++i) {
+        for (long round = 0; round < rounds; ++round) {
+            EVP_DigestInit_ex(ctx, EVP_md5(), NULL);
+            EVP_DigestUpdate(ctx, digests[i], md5kernel::DIGEST_LENGTH);
+            EVP_DigestFinal_ex(ctx, digests[i], NULL);
+        }
+    }
+    EVP_MD_CTX_destroy(ctx);
+}
+
+
+void iterateScalar(Digest* digests, size_t count, long rounds) {
+    for (size_t i = 0; i < count; ++i) {
+        md5kernel::iterateScalar(digests[i], rounds);
+    }
+}
+
+
+double run(const char* name, void (*iterate)(Digest*, size_t, long), const std::vector<unsigned char>& seeds,
+        size_t count, long rounds, std::vector<unsigned char>& out) {
+    out = seeds;
+    std::clock_t start = std::clock();
+    iterate(reinterpret_cast<Digest*>(&out[0]), count, rounds);
+    double seconds = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+    std::printf("%-14s %10.3f %14.0f\n", name, seconds, count / seconds);
+    return seconds;
+}
+
+} // namespace
+
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 4096;
+    long rounds = argc > 2 ? std::strtol(argv[2], NULL, 10) : 1000;
+
+    std::vector<unsigned char> seeds(count * md5kernel::DIGEST_LENGTH);
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        seeds[i] = static_cast<unsigned char>(i * 131 + 7);
+    }
+
+    std::printf("deriving %zu keys with %ld iterations, multi-buffer %s\n", count, rounds,
+                md5kernel::hasMultiBuffer() ? "available" : "unavailable");
+    std::printf("%-14s %10s %14s\n", "kernel", "cpu secs", "keys/sec");
+
+    std::vector<unsigned char> evp, scalar, multi;
+    run("evp", iterateEvp, seeds, count, rounds, evp);
+    run("scalar", iterateScalar, seeds, count, rounds, scalar);
+    run("multi-buffer", md5kernel::iterate, seeds, count, rounds, multi);
+
+    if (evp != scalar || evp != multi) {
+        std::fprintf(stderr, "kernel output mismatch\n");
+        return 1;
+    }
+    return 0;
+}
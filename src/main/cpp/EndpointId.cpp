@@ -0,0 +1,146 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointId.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/EndpointId.h>
+#include <pthread.h>
+#include <deque>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common {
+
+namespace {
+
+struct StringRefHash {
+    size_t operator()(const boost::string_ref& str) const {
+        return boost::hash_range(str.begin(), str.end());
+    }
+};
+
+/*
+ * Reader/writer lock over pthread_rwlock_t, so the library needs nothing
+ * beyond the pthreads it already links for std::thread
+ */
+class ReadWriteLock : boost::noncopyable {
+public:
+    ReadWriteLock() {
+        ::pthread_rwlock_init(&_lock, NULL);
+    }
+
+    ~ReadWriteLock() {
+        ::pthread_rwlock_destroy(&_lock);
+    }
+
+    class ReadGuard : boost::noncopyable {
+    public:
+        explicit ReadGuard(ReadWriteLock& lock) : _lock(lock._lock) {
+            ::pthread_rwlock_rdlock(&_lock);
+        }
+        ~ReadGuard() {
+            ::pthread_rwlock_unlock(&_lock);
+        }
+    private:
+        pthread_rwlock_t& _lock;
+    };
+
+    class WriteGuard : boost::noncopyable {
+    public:
+        explicit WriteGuard(ReadWriteLock& lock) : _lock(lock._lock) {
+            ::pthread_rwlock_wrlock(&_lock);
+        }
+        ~WriteGuard() {
+            ::pthread_rwlock_unlock(&_lock);
+        }
+    private:
+        pthread_rwlock_t& _lock;
+    };
+
+private:
+    pthread_rwlock_t _lock;
+};
+
+/*
+ * Hosts are stored in a deque so their text never moves, which lets the
+ * index be keyed by views of it and looked up without allocating. Lookups
+ * of known hosts, the common case, only take the lock shared.
+ */
+class InternTable {
+public:
+    InternTable() {
+        intern("");
+    }
+
+    uint32_t intern(boost::string_ref host) {
+        {
+            ReadWriteLock::ReadGuard lock(_lock);
+            Index::const_iterator itr = _index.find(host);
+            if (itr != _index.end()) {
+                return itr->second;
+            }
+        }
+
+        ReadWriteLock::WriteGuard lock(_lock);
+        Index::const_iterator itr = _index.find(host);
+        if (itr != _index.end()) {
+            return itr->second;
+        }
+        if (_hosts.size() > 0xFFFFFFFFu) {
+            BOOST_THROW_EXCEPTION(std::length_error("endpoint intern table is full"));
+        }
+
+        uint32_t id = static_cast<uint32_t>(_hosts.size());
+        _hosts.push_back(std::string(host.data(), host.size()));
+        _index.insert(std::make_pair(boost::string_ref(_hosts.back()), id));
+        return id;
+    }
+
+    const std::string& host(uint32_t id) {
+        ReadWriteLock::ReadGuard lock(_lock);
+        return _hosts[id];
+    }
+
+private:
+    typedef std::unordered_map<boost::string_ref, uint32_t, StringRefHash> Index;
+
+    ReadWriteLock _lock;
+    std::deque<std::string> _hosts;
+    Index _index;
+};
+
+InternTable& internTable() {
+    static InternTable table;
+    return table;
+}
+
+} // namespace
+
+
+const std::string& EndpointId::getHostText() const {
+    return internTable().host(getHostId());
+}
+
+
+uint32_t EndpointId::internHost(boost::string_ref host) {
+    return internTable().intern(host);
+}
+
+}} //namespace ::ezbake::common
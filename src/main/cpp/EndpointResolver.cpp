@@ -0,0 +1,85 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointResolver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/EndpointResolver.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+namespace ezbake { namespace common {
+
+unsigned int SocketAddress::port() const {
+    if (AF_INET6 == family()) {
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<const sockaddr_in*>(&storage)->sin_port);
+}
+
+
+void SocketAddress::setPort(unsigned int port) {
+    if (AF_INET6 == family()) {
+        reinterpret_cast<sockaddr_in6*>(&storage)->sin6_port = htons(static_cast<uint16_t>(port));
+    } else if (AF_INET == family()) {
+        reinterpret_cast<sockaddr_in*>(&storage)->sin_port = htons(static_cast<uint16_t>(port));
+    }
+}
+
+
+std::string SocketAddress::toString() const {
+    char host[INET6_ADDRSTRLEN] = "";
+    if (AF_INET6 == family()) {
+        inet_ntop(AF_INET6, &reinterpret_cast<const sockaddr_in6*>(&storage)->sin6_addr, host, sizeof(host));
+    } else {
+        inet_ntop(AF_INET, &reinterpret_cast<const sockaddr_in*>(&storage)->sin_addr, host, sizeof(host));
+    }
+    return HostAndPort::fromParts(host, port()).toString();
+}
+
+
+ResolveException::ResolveException(const std::string& host, int error)
+    : std::runtime_error("Unable to resolve " + host + ": " + gai_strerror(error)),
+      _error(error) {}
+
+
+int lookupHost(const std::string& host, SocketAddresses& addresses) {
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* results = NULL;
+    int error = getaddrinfo(host.c_str(), NULL, &hints, &results);
+    if (error) {
+        return error;
+    }
+
+    for (addrinfo* result = results; result; result = result->ai_next) {
+        SocketAddress address;
+        memset(&address.storage, 0, sizeof(address.storage));
+        memcpy(&address.storage, result->ai_addr, result->ai_addrlen);
+        address.length = result->ai_addrlen;
+        addresses.push_back(address);
+    }
+    freeaddrinfo(results);
+    return 0;
+}
+
+}} //namespace ::ezbake::common
@@ -0,0 +1,126 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * HostAndPortList.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/HostAndPortList.h>
+#include <algorithm>
+
+#if defined(__GNUC__) && defined(__SSE2__)
+#define EZBAKE_HOSTANDPORTLIST_SIMD 1
+#include <emmintrin.h>
+#endif
+
+namespace ezbake { namespace common {
+
+namespace {
+    inline bool isSpace(char c) {
+        return (' ' == c || '\t' == c || '\n' == c || '\r' == c);
+    }
+}
+
+
+HostAndPortList HostAndPortList::parse(boost::string_ref str, const boost::optional<unsigned int>& defaultPort) {
+    if (defaultPort && *defaultPort > HostAndPort::MAX_PORT) {
+        BOOST_THROW_EXCEPTION(std::out_of_range("port out of range"));
+    }
+
+    HostAndPortList list;
+    size_t chroot = str.find(CHROOT_DELIM);
+    if (boost::string_ref::npos != chroot) {
+        list._chroot.assign(str.data() + chroot, str.size() - chroot);
+        str = str.substr(0, chroot);
+    }
+
+    const char* data = str.data();
+    size_t length = str.size(), begin = 0, i = 0;
+
+#ifdef EZBAKE_HOSTANDPORTLIST_SIMD
+    //delimiters are found 16 characters at a time, and each entry parsed as its delimiter is found
+    const __m128i delims = _mm_set1_epi8(DELIM);
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, delims)));
+        while (mask) {
+            size_t position = i + static_cast<size_t>(__builtin_ctz(mask));
+            list.addEntry(data, begin, position, defaultPort);
+            begin = position + 1;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < length; ++i) {
+        if (DELIM == data[i]) {
+            list.addEntry(data, begin, i, defaultPort);
+            begin = i + 1;
+        }
+    }
+    list.addEntry(data, begin, length, defaultPort);
+    return list;
+}
+
+
+void HostAndPortList::sortAndDeduplicate() {
+    std::sort(_hosts.begin(), _hosts.end());
+    _hosts.erase(std::unique(_hosts.begin(), _hosts.end()), _hosts.end());
+}
+
+
+std::string HostAndPortList::toString() const {
+    std::string str;
+    for (std::vector<HostAndPort>::const_iterator itr = _hosts.begin(); itr != _hosts.end(); ++itr) {
+        if (itr != _hosts.begin()) {
+            str += DELIM;
+        }
+        str += itr->toString();
+    }
+    return str + _chroot;
+}
+
+
+void HostAndPortList::addEntry(const char* data, size_t begin, size_t end,
+        const boost::optional<unsigned int>& defaultPort) {
+    while (begin < end && isSpace(data[begin])) {
+        ++begin;
+    }
+    while (end > begin && isSpace(data[end - 1])) {
+        --end;
+    }
+    if (begin == end) {
+        return;
+    }
+
+    HostAndPort::Parsed parsed;
+    HostAndPort::ParseError error = HostAndPort::parse(boost::string_ref(data + begin, end - begin), parsed);
+    if (HostAndPort::PARSE_OK != error) {
+        EntryError entryError = { begin, end - begin, error };
+        _errors.push_back(entryError);
+        return;
+    }
+
+    std::string host(parsed.host.data(), parsed.host.size());
+    if (parsed.hasPort || defaultPort) {
+        _hosts.push_back(HostAndPort::fromParts(host, parsed.hasPort ? parsed.port : *defaultPort));
+    } else {
+        _hosts.push_back(HostAndPort::fromHost(host));
+    }
+}
+
+}} //namespace ::ezbake::common
@@ -0,0 +1,179 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointId.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_ENDPOINTID_H_
+#define EZBAKE_COMMON_ENDPOINTID_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <boost/throw_exception.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <ezbake/common/HostAndPort.h>
+
+namespace ezbake { namespace common {
+
+/**
+ * Compact, interned form of a HostAndPort for use as a map or cache key.
+ *
+ * The host text is interned in a process wide table that hands out 32 bit
+ * ids, and the id is packed with the port into a single 64 bit word, so
+ * copying, comparing and hashing never touch the host text. Interned hosts
+ * are kept for the life of the process, which suits the bounded set of
+ * hosts a service talks to.
+ *
+ * Ordering is by intern id rather than host text, so it is stable within a
+ * process but not between processes.
+ */
+class EndpointId
+{
+public:
+    /**
+     * Interns host, without a port
+     */
+    static EndpointId fromHost(boost::string_ref host) {
+        return EndpointId(static_cast<uint64_t>(internHost(host)) << HOST_SHIFT);
+    }
+
+    /**
+     * Interns host, with a port
+     *
+     * @throws std::out_of_range if port is greater than HostAndPort::MAX_PORT
+     */
+    static EndpointId fromParts(boost::string_ref host, unsigned int port) {
+        if (port > HostAndPort::MAX_PORT) {
+            BOOST_THROW_EXCEPTION(std::out_of_range("port out of range"));
+        }
+        return EndpointId((static_cast<uint64_t>(internHost(host)) << HOST_SHIFT) | HAS_PORT | port);
+    }
+
+    static EndpointId fromHostAndPort(const HostAndPort& hostAndPort) {
+        return hostAndPort.hasPort() ? fromParts(hostAndPort.getHostText(), hostAndPort.getPort())
+                                     : fromHost(hostAndPort.getHostText());
+    }
+
+public:
+    /**
+     * Creates the id of an empty host without a port
+     */
+    EndpointId() : _value(0) {}
+
+    /**
+     * Returns the interned host text, which stays valid for the life of the process
+     */
+    const std::string& getHostText() const;
+
+    uint32_t getHostId() const {
+        return static_cast<uint32_t>(_value >> HOST_SHIFT);
+    }
+
+    bool hasPort() const {
+        return (_value & HAS_PORT) != 0;
+    }
+
+    unsigned int getPort() const {
+        if (!hasPort()) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("no port defined"));
+        }
+        return static_cast<unsigned int>(_value & PORT_MASK);
+    }
+
+    unsigned int getPortOrDefault(unsigned int defaultPort) const {
+        return hasPort() ? static_cast<unsigned int>(_value & PORT_MASK) : defaultPort;
+    }
+
+    /**
+     * Returns the packed host id, port flag and port
+     */
+    uint64_t value() const {
+        return _value;
+    }
+
+    HostAndPort toHostAndPort() const {
+        return hasPort() ? HostAndPort::fromParts(getHostText(), getPort()) : HostAndPort::fromHost(getHostText());
+    }
+
+    std::string toString() const {
+        return toHostAndPort().toString();
+    }
+
+    size_t hash() const {
+        uint64_t mixed = _value * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(mixed ^ (mixed >> 32));
+    }
+
+    bool operator==(const EndpointId& rhs) const {
+        return _value == rhs._value;
+    }
+
+    bool operator!=(const EndpointId& rhs) const {
+        return _value != rhs._value;
+    }
+
+    bool operator<(const EndpointId& rhs) const {
+        return _value < rhs._value;
+    }
+
+    friend size_t hash_value(const EndpointId& id) {
+        return id.hash();
+    }
+
+    friend std::ostream& operator<< (std::ostream& stream, const EndpointId& id) {
+        stream << id.toString();
+        return stream;
+    }
+
+private:
+    static const unsigned int HOST_SHIFT = 32;
+    static const uint64_t HAS_PORT = 0x10000;
+    static const uint64_t PORT_MASK = 0xFFFF;
+
+    /**
+     * Returns the id of host in the intern table, adding it if it is new
+     *
+     * @throws std::length_error if the table is full
+     */
+    static uint32_t internHost(boost::string_ref host);
+
+    explicit EndpointId(uint64_t value) : _value(value) {}
+
+private:
+    uint64_t _value;
+};
+
+}} //namespace ::ezbake::common
+
+
+namespace std {
+
+template <>
+struct hash< ::ezbake::common::EndpointId> {
+    size_t operator()(const ::ezbake::common::EndpointId& id) const {
+        return id.hash();
+    }
+};
+
+} //namespace std
+
+#endif /* EZBAKE_COMMON_ENDPOINTID_H_ */
@@ -0,0 +1,367 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointResolver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_ENDPOINTRESOLVER_H_
+#define EZBAKE_COMMON_ENDPOINTRESOLVER_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <boost/optional.hpp>
+#include <boost/utility.hpp>
+#include <ezbake/common/EndpointId.h>
+#include <ezbake/common/HostAndPort.h>
+#include <ezbake/common/lrucache/LRUTimedCache.h>
+#include <ezbake/common/utils/ThreadPool.h>
+
+namespace ezbake { namespace common {
+
+/**
+ * A resolved socket address, ready for connect()
+ */
+struct SocketAddress {
+    sockaddr_storage storage;
+    socklen_t length;
+
+    const sockaddr* get() const {
+        return reinterpret_cast<const sockaddr*>(&storage);
+    }
+
+    int family() const {
+        return storage.ss_family;
+    }
+
+    unsigned int port() const;
+    void setPort(unsigned int port);
+
+    /**
+     * Returns the numeric address and port, such as "127.0.0.1:80" or "[::1]:80"
+     */
+    std::string toString() const;
+
+    bool operator==(const SocketAddress& rhs) const {
+        return length == rhs.length && 0 == memcmp(&storage, &rhs.storage, length);
+    }
+
+    bool operator<(const SocketAddress& rhs) const {
+        return length < rhs.length || (length == rhs.length && memcmp(&storage, &rhs.storage, length) < 0);
+    }
+};
+
+typedef std::vector<SocketAddress> SocketAddresses;
+
+
+/**
+ * Raised when a host name cannot be resolved
+ */
+class ResolveException : public std::runtime_error {
+public:
+    /**
+     * @param host      the host that failed to resolve
+     * @param error     getaddrinfo() error code
+     */
+    ResolveException(const std::string& host, int error);
+
+    int error() const {
+        return _error;
+    }
+
+private:
+    int _error;
+};
+
+
+/**
+ * Resolves host with getaddrinfo(), the default lookup of EndpointResolver
+ *
+ * @param host          host name or numeric address
+ * @param addresses     receives the stream socket addresses of host, with port 0
+ *
+ * @return 0 or a getaddrinfo() error code
+ */
+int lookupHost(const std::string& host, SocketAddresses& addresses);
+
+
+/**
+ * Resolves HostAndPorts to socket addresses without blocking the caller.
+ *
+ * Lookups run on a small pool of worker threads. Results are cached by host
+ * in an LRUTimedCache: successful ones for the positive TTL, failures for the
+ * shorter negative TTL. Concurrent requests for a host that is being looked
+ * up wait on that lookup rather than starting their own. A cached result
+ * within the refresh window of its expiry is still returned, and a new lookup
+ * is started in the background so hot hosts never miss. A failed refresh
+ * leaves the previous result in place.
+ *
+ * Time is read from the Clock type (see CacheClock.h), so tests can drive
+ * expiry with ManualClock.
+ */
+template <typename Clock = lrucache::SystemClock>
+class BasicEndpointResolver : boost::noncopyable {
+public:
+    static const size_t DEFAULT_THREADS = 2;
+    static const unsigned int DEFAULT_CAPACITY = 1000;
+    static const uint64_t DEFAULT_POSITIVE_TTL = 300;
+    static const uint64_t DEFAULT_NEGATIVE_TTL = 30;
+    static const uint64_t DEFAULT_REFRESH_WINDOW = 60;
+
+    /**
+     * Receives the result of a request: the addresses on success, or the error
+     */
+    typedef std::function<void (SocketAddresses* addresses, std::exception_ptr error)> Completion;
+
+    /**
+     * Looks up the addresses of a host, returning 0 or a getaddrinfo() error code
+     */
+    typedef std::function<int (const std::string& host, SocketAddresses& addresses)> Lookup;
+
+public:
+    /**
+     * @param threads           number of lookup threads, at least one is started
+     * @param capacity          maximum number of hosts cached
+     * @param positiveTtl       seconds a successful lookup is cached
+     * @param negativeTtl       seconds a failed lookup is cached
+     * @param refreshWindow     seconds before expiry that a cached lookup is refreshed
+     * @param lookup            resolves host names, getaddrinfo() by default
+     */
+    explicit BasicEndpointResolver(size_t threads = DEFAULT_THREADS,
+            unsigned int capacity = DEFAULT_CAPACITY,
+            uint64_t positiveTtl = DEFAULT_POSITIVE_TTL,
+            uint64_t negativeTtl = DEFAULT_NEGATIVE_TTL,
+            uint64_t refreshWindow = DEFAULT_REFRESH_WINDOW,
+            const Lookup& lookup = lookupHost)
+        : _cache(capacity, positiveTtl),
+          _negativeTtl(std::min(negativeTtl, positiveTtl)),
+          _refreshAge(positiveTtl - std::min(refreshWindow, positiveTtl)),
+          _lookup(lookup),
+          _pool(threads) {}
+
+    /**
+     * Resolves an endpoint. The addresses carry the endpoint's port, or 0 if
+     * it has none.
+     *
+     * @return future holding the addresses, or a ResolveException
+     */
+    std::future<SocketAddresses> resolve(const HostAndPort& endpoint) {
+        std::shared_ptr<std::promise<SocketAddresses> > promise(new std::promise<SocketAddresses>());
+        resolve(endpoint, [promise](SocketAddresses* addresses, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(*addresses);
+            }
+        });
+        return promise->get_future();
+    }
+
+    /**
+     * Resolves an endpoint, passing the addresses or a ResolveException to the
+     * completion. A cached result completes on the calling thread, others
+     * complete on a lookup thread.
+     */
+    void resolve(const HostAndPort& endpoint, const Completion& completion) {
+        const std::string& host = endpoint.getHostText();
+        EndpointId key = EndpointId::fromHost(host);
+        unsigned int port = endpoint.getPortOrDefault(0);
+
+        boost::optional<Resolution> cached = cachedResolution(key);
+        if (!cached) {
+            Waiter waiter = { port, completion };
+            startLookup(key, host, &waiter);
+            return;
+        }
+
+        if (0 == cached->error && _cache.clock().now() >= cached->resolvedAt + _refreshAge) {
+            startLookup(key, host, NULL);
+        }
+        complete(*cached, host, port, completion);
+    }
+
+    /**
+     * Returns the cached addresses of an endpoint without starting a lookup
+     *
+     * @return the addresses, or none if the endpoint is not cached or failed to resolve
+     */
+    boost::optional<SocketAddresses> cached(const HostAndPort& endpoint) {
+        boost::optional<Resolution> cached = cachedResolution(EndpointId::fromHost(endpoint.getHostText()));
+        if (!cached || cached->error) {
+            return boost::none;
+        }
+        return withPort(cached->addresses, endpoint.getPortOrDefault(0));
+    }
+
+    /**
+     * Drops the cached result for the host of an endpoint
+     */
+    void invalidate(const HostAndPort& endpoint) {
+        _cache.remove(EndpointId::fromHost(endpoint.getHostText()));
+    }
+
+    /**
+     * Returns the number of hosts being looked up
+     */
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _inflight.size();
+    }
+
+    /**
+     * Return the clock the cache reads time from
+     */
+    Clock& clock() {
+        return _cache.clock();
+    }
+
+private:
+    struct Resolution {
+        uint64_t resolvedAt;
+        int error;
+        SocketAddresses addresses;
+
+        bool operator==(const Resolution& rhs) const {
+            return resolvedAt == rhs.resolvedAt && error == rhs.error && addresses == rhs.addresses;
+        }
+
+        bool operator<(const Resolution& rhs) const {
+            if (resolvedAt != rhs.resolvedAt) {
+                return resolvedAt < rhs.resolvedAt;
+            }
+            return (error != rhs.error) ? error < rhs.error : addresses < rhs.addresses;
+        }
+    };
+
+    struct Waiter {
+        unsigned int port;
+        Completion completion;
+    };
+
+    typedef std::unordered_map<EndpointId, std::vector<Waiter> > InflightMap;
+
+    /*
+     * The cache expires entries after the positive TTL; failures are dropped
+     * here once the shorter negative TTL has passed.
+     */
+    boost::optional<Resolution> cachedResolution(const EndpointId& key) {
+        boost::optional<Resolution> cached = _cache.get(key);
+        if (cached && cached->error && _cache.clock().now() >= cached->resolvedAt + _negativeTtl) {
+            return boost::none;
+        }
+        return cached;
+    }
+
+    void startLookup(const EndpointId& key, const std::string& host, const Waiter* waiter) {
+        {//synchronized
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename InflightMap::iterator itr = _inflight.find(key);
+            bool started = (itr != _inflight.end());
+            if (!started) {
+                itr = _inflight.insert(std::make_pair(key, std::vector<Waiter>())).first;
+            }
+            if (waiter) {
+                itr->second.push_back(*waiter);
+            }
+            if (started) {
+                return;
+            }
+        }
+        _pool.submit([this, key, host]() { runLookup(key, host); });
+    }
+
+    void runLookup(const EndpointId& key, const std::string& host) {
+        Resolution resolution = { 0, 0, SocketAddresses() };
+        try {
+            resolution.error = _lookup(host, resolution.addresses);
+        } catch (...) {
+            resolution.error = EAI_FAIL;
+        }
+        resolution.resolvedAt = _cache.clock().now();
+
+        //a failed refresh keeps the result it was refreshing
+        boost::optional<Resolution> current = _cache.get(key);
+        if (0 == resolution.error || !current || current->error) {
+            _cache.replace(key, resolution);
+        }
+
+        std::vector<Waiter> waiters;
+        {//synchronized
+            std::lock_guard<std::mutex> lock(_mutex);
+            typename InflightMap::iterator itr = _inflight.find(key);
+            waiters.swap(itr->second);
+            _inflight.erase(itr);
+        }
+
+        for (typename std::vector<Waiter>::iterator itr = waiters.begin(); itr != waiters.end(); ++itr) {
+            complete(resolution, host, itr->port, itr->completion);
+        }
+    }
+
+    static SocketAddresses withPort(const SocketAddresses& addresses, unsigned int port) {
+        SocketAddresses result(addresses);
+        for (SocketAddresses::iterator itr = result.begin(); itr != result.end(); ++itr) {
+            itr->setPort(port);
+        }
+        return result;
+    }
+
+    static void complete(const Resolution& resolution, const std::string& host, unsigned int port,
+            const Completion& completion) {
+        try {
+            if (resolution.error) {
+                completion(NULL, std::make_exception_ptr(ResolveException(host, resolution.error)));
+            } else {
+                SocketAddresses addresses = withPort(resolution.addresses, port);
+                completion(&addresses, std::exception_ptr());
+            }
+        } catch (...) {
+            //completions report their own failures
+        }
+    }
+
+private:
+    lrucache::LRUTimedCache<EndpointId, Resolution, Clock> _cache;
+    const uint64_t _negativeTtl;
+    const uint64_t _refreshAge;
+    const Lookup _lookup;
+
+    mutable std::mutex _mutex;
+    InflightMap _inflight;
+
+    //declared last so queued lookups finish before the members they use are destroyed
+    utils::ThreadPool _pool;
+};
+
+typedef BasicEndpointResolver<> EndpointResolver;
+
+}} //namespace ::ezbake::common
+
+#endif /* EZBAKE_COMMON_ENDPOINTRESOLVER_H_ */
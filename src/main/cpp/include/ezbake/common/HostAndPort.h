@@ -22,11 +22,14 @@
 #ifndef EZBAKE_COMMON_HOSTANDPORT_H_
 #define EZBAKE_COMMON_HOSTANDPORT_H_
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <cstring>
 #include <stdexcept>
 #include <string>
 #include <ostream>
 #include <boost/optional.hpp>
-#include <boost/lexical_cast.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <boost/exception/all.hpp>
 #include <boost/throw_exception.hpp>
 
@@ -48,15 +51,167 @@ public:
         return HostAndPort(host, port);
     }
 
-    static HostAndPort fromString(const std::string& str) {
-        size_t delimPosition = str.find(DELIM);
+    /**
+     * Reasons a host and port string can fail to parse
+     */
+    enum ParseError {
+        PARSE_OK = 0,
+        UNTERMINATED_BRACKET,       //"[::1" has no closing bracket
+        UNEXPECTED_CHARACTERS,      //text after a closing bracket other than a port
+        INVALID_PORT,               //the port is not a decimal number
+        PORT_OUT_OF_RANGE,          //the port is greater than MAX_PORT
+        EMPTY_HOST,                 //":80" or "[]:80" has no host
+        INVALID_IPV6_LITERAL        //several delimiters outside brackets, but not an IPv6 address
+    };
 
-        if (std::string::npos == delimPosition) {
-            return fromHost(str);
+    /**
+     * Host and port parsed by parse(), viewing the parsed text
+     */
+    struct Parsed {
+        boost::string_ref host;     //host text, without the brackets of an IPv6 literal
+        unsigned int port;          //port, when hasPort is set
+        bool hasPort;
+    };
+
+    /**
+     * Returns a description of a parse error
+     */
+    static const char* describe(ParseError error) {
+        switch (error) {
+        case PARSE_OK:              return "no error";
+        case UNTERMINATED_BRACKET:  return "missing closing bracket";
+        case UNEXPECTED_CHARACTERS: return "unexpected characters after closing bracket";
+        case INVALID_PORT:          return "port is not a number";
+        case PORT_OUT_OF_RANGE:     return "port out of range";
+        case EMPTY_HOST:            return "host is empty";
+        case INVALID_IPV6_LITERAL:  return "multiple delimiters in a host that is not an IPv6 address";
+        }
+        return "unknown error";
+    }
+
+    /**
+     * Parses "host", "host:port", "[ipv6]", "[ipv6]:port" or a bare IPv6
+     * literal such as "::1", which has no port. Text with more than one
+     * delimiter outside brackets must be a valid IPv6 address, so that
+     * "host:80:81" is rejected rather than taken as a host. Does not allocate
+     * or throw.
+     *
+     * @param str       text to parse, which must outlive the host view in result
+     * @param result    receives the host and port when parsing succeeds
+     *
+     * @return PARSE_OK or the reason str is malformed
+     */
+    static ParseError parse(boost::string_ref str, Parsed& result) {
+        boost::string_ref host = str, port;
+        bool hasDelim = false;
+
+        if (!str.empty() && '[' == str[0]) {
+            size_t close = str.find(']');
+            if (boost::string_ref::npos == close) {
+                return UNTERMINATED_BRACKET;
+            }
+            host = str.substr(1, close - 1);
+            boost::string_ref rest = str.substr(close + 1);
+            if (!rest.empty() && DELIM != rest[0]) {
+                return UNEXPECTED_CHARACTERS;
+            }
+            hasDelim = !rest.empty();
+            port = rest.substr(hasDelim ? 1 : 0);
+        } else {
+            size_t delimPosition = str.find(DELIM);
+            if (boost::string_ref::npos != delimPosition) {
+                if (str.rfind(DELIM) == delimPosition) {
+                    host = str.substr(0, delimPosition);
+                    port = str.substr(delimPosition + 1);
+                    hasDelim = true;
+                } else if (!isIPv6Literal(str)) {
+                    //more than one delimiter is only valid as an IPv6 literal without a port
+                    return INVALID_IPV6_LITERAL;
+                }
+            }
+        }
+
+        if (host.empty()) {
+            return EMPTY_HOST;
+        }
+
+        //"host:" is what toString() gives for a host without a port
+        result.host = host;
+        result.port = 0;
+        result.hasPort = hasDelim && !port.empty();
+        if (!result.hasPort) {
+            return PARSE_OK;
+        }
+
+        for (size_t i = 0; i < port.size(); ++i) {
+            if (port[i] < '0' || port[i] > '9') {
+                return INVALID_PORT;
+            }
+            if (result.port <= MAX_PORT) {
+                result.port = (result.port * 10) + static_cast<unsigned int>(port[i] - '0');
+            }
         }
+        return (result.port > MAX_PORT) ? PORT_OUT_OF_RANGE : PARSE_OK;
+    }
+
+    /**
+     * Returns true if text is an IPv6 address, optionally followed by a
+     * "%zone" index as in "fe80::1%eth0". Does not allocate.
+     */
+    static bool isIPv6Literal(boost::string_ref text) {
+        size_t zone = text.find('%');
+        if (boost::string_ref::npos != zone) {
+            if (zone + 1 == text.size()) {
+                return false;
+            }
+            text = text.substr(0, zone);
+        }
+
+        //inet_pton needs a terminated string
+        char address[INET6_ADDRSTRLEN];
+        if (text.size() >= sizeof(address)) {
+            return false;
+        }
+        std::memcpy(address, text.data(), text.size());
+        address[text.size()] = '\0';
+
+        struct in6_addr parsed;
+        return (1 == ::inet_pton(AF_INET6, address, &parsed));
+    }
+
+    /**
+     * Parses str as parse() does, without throwing
+     *
+     * @param error     set to PARSE_OK or the reason str is malformed
+     *
+     * @return the host and port, or none if str is malformed
+     */
+    static boost::optional<HostAndPort> tryFromString(boost::string_ref str, ParseError& error) {
+        Parsed parsed;
+        error = parse(str, parsed);
+        if (PARSE_OK != error) {
+            return boost::none;
+        }
+        return parsed.hasPort ? fromParts(std::string(parsed.host.data(), parsed.host.size()), parsed.port)
+                              : fromHost(std::string(parsed.host.data(), parsed.host.size()));
+    }
 
-        unsigned int port = boost::lexical_cast<unsigned int>(str.substr(delimPosition+1));
-        return fromParts(str.substr(0, delimPosition), port);
+    /**
+     * Parses str as parse() does
+     *
+     * @throws std::out_of_range if the port is greater than MAX_PORT
+     * @throws std::invalid_argument if str is otherwise malformed
+     */
+    static HostAndPort fromString(boost::string_ref str) {
+        ParseError error;
+        boost::optional<HostAndPort> result = tryFromString(str, error);
+        if (PORT_OUT_OF_RANGE == error) {
+            BOOST_THROW_EXCEPTION(std::out_of_range(describe(error)));
+        }
+        if (!result) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument(describe(error)));
+        }
+        return *result;
     }
 
     inline std::string getHostText() const {
@@ -71,11 +226,7 @@ public:
     }
 
     inline unsigned int getPortOrDefault(unsigned int defaultPort) const {
-        try {
-            return getPort();
-        } catch (const std::invalid_argument& e) {
-            return defaultPort;
-        }
+        return (_port ? *_port : defaultPort);
     }
 
     inline bool hasPort() const {
@@ -83,8 +234,10 @@ public:
     }
 
     inline std::string toString() const {
-        return (hasPort() ? _host + DELIM + std::to_string(static_cast<long long unsigned int>(*_port))
-                          : _host + DELIM);
+        //IPv6 literals are bracketed so the port delimiter is unambiguous
+        std::string host = (std::string::npos == _host.find(DELIM)) ? _host : "[" + _host + "]";
+        return (hasPort() ? host + DELIM + std::to_string(static_cast<long long unsigned int>(*_port))
+                          : host + DELIM);
     }
 
     bool operator==(const HostAndPort& rhs) const {
@@ -106,10 +259,8 @@ public:
         if (this->_host == rhs._host) {
             if (this->hasPort() && rhs.hasPort()) {
                 return (this->getPort() < rhs.getPort());
-            } else if (this->hasPort()) {
-                return false;
             }
-            return true;
+            return (!this->hasPort() && rhs.hasPort());
         }
 
         return (this->_host < rhs._host);
@@ -0,0 +1,113 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * HostAndPortList.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_HOSTANDPORTLIST_H_
+#define EZBAKE_COMMON_HOSTANDPORTLIST_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <boost/optional.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <ezbake/common/HostAndPort.h>
+
+namespace ezbake { namespace common {
+
+/**
+ * Hosts of a comma separated connect string such as the ZooKeeper and
+ * Accumulo "h1:2181,h2:2181" form, parsed in a single pass. A trailing
+ * ZooKeeper chroot suffix, as in "h1:2181,h2:2181/app", is split off and
+ * kept in chroot().
+ */
+class HostAndPortList
+{
+public:
+    static const char DELIM = ',';
+    static const char CHROOT_DELIM = '/';
+
+    /**
+     * An entry of the connect string that failed to parse
+     */
+    struct EntryError {
+        size_t offset;                  //offset of the entry in the connect string
+        size_t length;                  //length of the entry, without surrounding whitespace
+        HostAndPort::ParseError error;
+    };
+
+    /**
+     * Parses a connect string. Everything from the first '/' on is the chroot
+     * suffix. Each entry before it is parsed as HostAndPort::parse() does,
+     * ignoring whitespace around it. Empty entries are skipped, and malformed
+     * ones are reported in errors() while the rest are kept.
+     *
+     * @param str           connect string
+     * @param defaultPort   port given to entries without one, if any
+     *
+     * @throws std::out_of_range if the default port is greater than HostAndPort::MAX_PORT
+     */
+    static HostAndPortList parse(boost::string_ref str,
+            const boost::optional<unsigned int>& defaultPort = boost::none);
+
+public:
+    HostAndPortList() {}
+
+    /**
+     * Sorts the hosts and removes duplicates
+     */
+    void sortAndDeduplicate();
+
+    const std::vector<HostAndPort>& hosts() const {
+        return _hosts;
+    }
+
+    /**
+     * Returns the chroot suffix of the connect string, including its leading
+     * '/', or an empty string if it has none
+     */
+    const std::string& chroot() const {
+        return _chroot;
+    }
+
+    const std::vector<EntryError>& errors() const {
+        return _errors;
+    }
+
+    bool hasErrors() const {
+        return !_errors.empty();
+    }
+
+    /**
+     * Returns the hosts, followed by the chroot suffix, as a connect string
+     */
+    std::string toString() const;
+
+private:
+    void addEntry(const char* data, size_t begin, size_t end, const boost::optional<unsigned int>& defaultPort);
+
+private:
+    std::vector<HostAndPort> _hosts;
+    std::vector<EntryError> _errors;
+    std::string _chroot;
+};
+
+}} //namespace ::ezbake::common
+
+#endif /* EZBAKE_COMMON_HOSTANDPORTLIST_H_ */
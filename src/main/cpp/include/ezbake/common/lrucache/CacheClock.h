@@ -0,0 +1,90 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CacheClock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_LRUCACHE_CACHECLOCK_H_
+#define EZBAKE_COMMON_LRUCACHE_CACHECLOCK_H_
+
+#include <stdint.h>
+#include <ctime>
+#include <atomic>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common { namespace lrucache {
+
+/*
+ * Clocks used by the timed caches. A clock only needs to provide
+ *
+ *     uint64_t now() const;
+ *
+ * returning the current time in seconds.
+ */
+
+
+/**
+ * Wall clock time in seconds since the unix epoch
+ */
+class SystemClock {
+public:
+    uint64_t now() const {
+        return static_cast<uint64_t>(::time(NULL));
+    }
+};
+
+
+/**
+ * A clock that only moves when told to. Used to drive timed caches
+ * deterministically from tests and trace simulations.
+ *
+ * Reads and updates are thread-safe.
+ */
+class ManualClock : boost::noncopyable {
+public:
+    explicit ManualClock(uint64_t start = 0) : _now(start) {}
+
+    uint64_t now() const {
+        return _now.load();
+    }
+
+    /**
+     * Set the current time
+     *
+     * @param now in seconds
+     */
+    void set(uint64_t now) {
+        _now.store(now);
+    }
+
+    /**
+     * Move the clock forward
+     *
+     * @param seconds to advance by
+     */
+    void advance(uint64_t seconds) {
+        _now.fetch_add(seconds);
+    }
+
+private:
+    std::atomic<uint64_t> _now;
+};
+
+}}} // namespace ::ezbake::common::lrucache
+
+#endif /* EZBAKE_COMMON_LRUCACHE_CACHECLOCK_H_ */
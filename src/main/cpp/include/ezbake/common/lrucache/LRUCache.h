@@ -22,8 +22,10 @@
 #ifndef EZBAKE_COMMON_LRUCACHE_LRUCACHE_H_
 #define EZBAKE_COMMON_LRUCACHE_LRUCACHE_H_
 
+#include <iterator>
 #include <list>
 #include <mutex>
+#include <set>
 #include <unordered_set>
 #include <boost/optional.hpp>
 #include <boost/foreach.hpp>
@@ -37,19 +39,71 @@
 namespace ezbake { namespace common { namespace lrucache { 
 
 
+/**
+ * Locking policy that synchronizes every cache operation on a recursive mutex
+ */
+class RecursiveMutexLocking {
+public:
+    typedef std::recursive_mutex Mutex;
+};
+
+
+/**
+ * Locking policy for caches that are confined to a single thread
+ */
+class NoLocking {
+public:
+    class Mutex {
+    public:
+        void lock() {}
+        void unlock() {}
+        bool try_lock() { return true; }
+    };
+};
+
+
+/**
+ * Eviction policy that moves an entry to the most recently used position each
+ * time it is read, so the least recently used entry is evicted first
+ */
+class LruEviction {
+public:
+    template <typename CacheType, typename Iterator>
+    static void accessed(CacheType& cache, Iterator entry) {
+        cache.right.relocate(cache.right.end(), cache.project_right(entry));
+    }
+};
+
+
+/**
+ * Eviction policy that leaves entries in insertion order, so the oldest entry
+ * is evicted first. Reads do not modify the cache.
+ */
+class FifoEviction {
+public:
+    template <typename CacheType, typename Iterator>
+    static void accessed(CacheType&, Iterator) {}
+};
+
+
 /**
  * A cache implementation with a configurable size limit (default is to not have a limit set)
  * which removes the least recently used entry if an entry is added when full.
  *
- * Get and Put access are synchronized and thread-safe
+ * Locking and eviction are policies fixed at compile time, so only the
+ * destructor and clear() are virtual; clear() lets a subclass drop its own
+ * bookkeeping however the cache is cleared. By default get and put access are synchronized and
+ * thread-safe, and the least recently used entry is evicted.
  */
-
-template <typename K, typename V>
+template <typename K, typename V,
+          typename LockingPolicy = RecursiveMutexLocking,
+          typename EvictionPolicy = LruEviction>
 class LRUCache : boost::noncopyable {
 public:
     typedef typename std::pair<K, V> Entry;
     typedef typename std::set<V, std::less<V>, std::allocator<V> > ValueSet;
     typedef typename std::set<Entry, std::less<Entry>, std::allocator<Entry> > Set;
+    typedef typename LockingPolicy::Mutex Mutex;
 
 
 protected:
@@ -84,7 +138,7 @@ public:
      *
      * @return capacity of cache. If '0' returns, cache is not capacity limited
      */
-    virtual unsigned int capacity() const {
+    unsigned int capacity() const {
         return _capacity;
     }
 
@@ -93,7 +147,7 @@ public:
      */
     bool containsKey(const K& lookupKey) {
         //synchronized
-        std::lock_guard<std::recursive_mutex> lock(_m);
+        std::lock_guard<Mutex> lock(_m);
         return (_cache.left.find(lookupKey) != _cache.left.end());
     }
 
@@ -108,7 +162,7 @@ public:
      * Removes all of the mappings from the cache.
      */
     virtual void clear() {
-        std::lock_guard<std::recursive_mutex> lock(_m);
+        std::lock_guard<Mutex> lock(_m);
         _cache.clear();
     }
 
@@ -121,7 +175,7 @@ public:
         Set set;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
             BOOST_FOREACH(KeyViewConstRef entry, _cache.left) {
                 set.insert(Entry(entry.first, entry.second));
             }
@@ -142,7 +196,7 @@ public:
         ValueSet set;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
             KeyViewItrRange range = _cache.left.equal_range(key);
             KeyViewItr itr = range.first;
             do {
@@ -167,16 +221,16 @@ public:
         KeyViewItr entry;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
 
             if (getLruEntry(key, entry)) {
                 retVal = entry->second;
 
                 /*
-                 * Relocate the entry based on our list view (right view of bimap)
-                 * This marks the entry as the most recently used
+                 * Let the eviction policy reorder our list view (right view of bimap).
+                 * For LRU eviction this marks the entry as the most recently used
                  */
-                _cache.right.relocate(_cache.right.end(), _cache.project_right(entry));
+                EvictionPolicy::accessed(_cache, entry);
             }
         }
 
@@ -194,7 +248,7 @@ public:
         boost::optional<K> key;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
             BOOST_FOREACH(ValueViewConstRef valueEntry, _cache.right) {
                 if (valueEntry.first == lookupValue) {
                     key = valueEntry.second;
@@ -209,16 +263,24 @@ public:
     /**
      * Returns true if this cache is empty
      */
-    virtual bool isEmpty() {
-        return (size() == 0);
+    bool isEmpty() {
+        //synchronized
+        std::lock_guard<Mutex> lock(_m);
+        return _cache.empty();
     }
 
     /**
      * Returns true if this cache is full and no new entry can be added
      * without removing the least recently used entry
      */
-    virtual bool isFull() {
-        return (_capacity == 0) ? false : (size() >= _capacity);
+    bool isFull() {
+        if (_capacity == 0) {
+            return false;
+        }
+
+        //synchronized
+        std::lock_guard<Mutex> lock(_m);
+        return (_cache.size() >= _capacity);
     }
 
     /**
@@ -235,7 +297,7 @@ public:
         KeyViewItr entry;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
 
             if (getLruEntry(key, entry)) {
                 retVal = entry->second;
@@ -256,7 +318,7 @@ public:
      */
     void put(const K& key, const V& value) {
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
 
             //check for a duplicate Key-Value pair
             KeyViewItr itr = findEntry(key, value);
@@ -265,14 +327,51 @@ public:
                 _cache.left.erase(itr);
             }
 
-            //if we've reached capacity
-            if (_capacity && (_cache.size() >= _capacity)) {
-                //remove least recently used Key-Value pair
-                _cache.right.erase(_cache.right.begin());
+            insert(key, value);
+        }
+    }
+
+    /**
+     * Put an element into the cache only if no value maps to the key. The lookup
+     * and the insert happen under one lock, so callers racing to fill the same
+     * key leave a single entry.
+     *
+     * @param key used for lookup
+     * @param value associated with key
+     *
+     * @return boost optional set with the least recently accessed value already
+     *         mapped to the key, or empty if the specified value was inserted
+     */
+    boost::optional<V> putIfAbsent(const K& key, const V& value) {
+        boost::optional<V> existing;
+        KeyViewItr entry;
+
+        {//synchronized
+            std::lock_guard<Mutex> lock(_m);
+
+            if (getLruEntry(key, entry)) {
+                existing = entry->second;
+                EvictionPolicy::accessed(_cache, entry);
+            } else {
+                insert(key, value);
             }
+        }
+
+        return existing;
+    }
 
-            //add to cache
-            _cache.insert(CacheEntry(key, value));
+    /**
+     * Put an element into the cache replacing every value mapped to the key,
+     * so that afterwards the key maps to the specified value only
+     *
+     * @param key used for lookup
+     * @param value associated with key
+     */
+    void replace(const K& key, const V& value) {
+        {//synchronized
+            std::lock_guard<Mutex> lock(_m);
+            _cache.left.erase(key);
+            insert(key, value);
         }
     }
 
@@ -287,7 +386,7 @@ public:
         std::list<V> valuesRemoved;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
 
             KeyViewItrRange range = _cache.left.equal_range(key);
             for(KeyViewItr itr = range.first; itr != range.second; itr++) {
@@ -313,7 +412,7 @@ public:
         boost::optional<V> valueRemoved;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(_m);
+            std::lock_guard<Mutex> lock(_m);
 
             KeyViewItr itr = findEntry(key, value);
             if (itr != _cache.left.end()) {
@@ -328,24 +427,24 @@ public:
     /**
      * Return the current size of the cache
      */
-    virtual unsigned int size() {
+    unsigned int size() {
         //synchronized
-        std::lock_guard<std::recursive_mutex> lock(_m);
+        std::lock_guard<Mutex> lock(_m);
         return static_cast<unsigned int>(_cache.size());
     }
 
     /**
      * Returns the number of values that map to the specified key
      */
-    virtual unsigned int valueRange(const K& key) {
+    unsigned int valueRange(const K& key) {
         //synchronized
-        std::lock_guard<std::recursive_mutex> lock(_m);
+        std::lock_guard<Mutex> lock(_m);
         KeyViewItrRange range = _cache.left.equal_range(key);
         return static_cast<unsigned int>(std::distance(range.first, range.second));
     }
 
 protected:
-    std::recursive_mutex& mutex() {
+    Mutex& mutex() {
         return _m;
     }
 
@@ -354,6 +453,17 @@ protected:
     }
 
 private:
+    void insert(const K& key, const V& value) {
+        //if we've reached capacity
+        if (_capacity && (_cache.size() >= _capacity)) {
+            //remove least recently used Key-Value pair
+            _cache.right.erase(_cache.right.begin());
+        }
+
+        //add to cache
+        _cache.insert(CacheEntry(key, value));
+    }
+
     KeyViewItr findEntry(const K& key, const V& value) {
         KeyViewItrRange range = _cache.left.equal_range(key);
         for(KeyViewItr itr = range.first; itr != range.second; itr++) {
@@ -365,17 +475,26 @@ private:
     }
 
     bool getLruEntry(const K& key, KeyViewItr& entry) {
-        if (_cache.left.find(key) == _cache.left.end()) {
+        KeyViewItrRange range = _cache.left.equal_range(key);
+        if (range.first == range.second) {
             //Key doesn't exist in cache.
             return false;
         }
 
-        KeyViewItrRange range = _cache.left.equal_range(key);
         entry = range.first;
-        for(KeyViewItr itr = range.first; itr != range.second; itr++) {
-            //search the range of values that map to the same key and get the least recently used
-            if(std::distance(_cache.right.begin(), _cache.project_right(itr)) <
-               std::distance(_cache.right.begin(), _cache.project_right(entry))) {
+        if (std::next(range.first) == range.second) {
+            //only one value maps to the key
+            return true;
+        }
+
+        //search the range of values that map to the same key and get the least recently used
+        typename CacheType::right_map::difference_type lruPosition =
+                std::distance(_cache.right.begin(), _cache.project_right(entry));
+        for(KeyViewItr itr = std::next(range.first); itr != range.second; itr++) {
+            typename CacheType::right_map::difference_type position =
+                    std::distance(_cache.right.begin(), _cache.project_right(itr));
+            if (position < lruPosition) {
+                lruPosition = position;
                 entry = itr;
             }
         }
@@ -385,7 +504,7 @@ private:
 
 private:
     //synchronization mutex
-    std::recursive_mutex _m;
+    Mutex _m;
 
     //maximum capacity of cache
     unsigned int _capacity;
@@ -394,6 +513,18 @@ private:
     CacheType _cache;
 };
 
+/**
+ * An LRUCache for use from a single thread, without any locking
+ */
+template <typename K, typename V>
+using UnsynchronizedLRUCache = LRUCache<K, V, NoLocking, LruEviction>;
+
+/**
+ * A synchronized cache that evicts entries in insertion order
+ */
+template <typename K, typename V>
+using FifoCache = LRUCache<K, V, RecursiveMutexLocking, FifoEviction>;
+
 }}} // namespace ::ezbake::common::lrucache
 
 #endif /* EZBAKE_COMMON_LRUCACHE_LRUCACHE_H_ */
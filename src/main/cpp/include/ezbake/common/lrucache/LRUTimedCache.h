@@ -23,63 +23,156 @@
 #define EZBAKE_COMMON_LRUCACHE_LRUTIMEDCACHE_H_
 
 #include <stdint.h>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <type_traits>
+#include <vector>
 
 #include <ezbake/common/lrucache/LRUCache.h>
-#include <boost/date_time.hpp>
+#include <ezbake/common/lrucache/CacheClock.h>
 #include <boost/format.hpp>
 
+/*
+ * No longer used by the cache, which reads time through its Clock. Kept for
+ * one release for code that relied on it to reach boost::posix_time.
+ */
+#include <boost/date_time.hpp>
+
 namespace ezbake { namespace common { namespace lrucache {
 
+/**
+ * Bookkeeping header stored with every timed cache value.
+ *
+ * The deadline is kept in seconds relative to the owning cache's epoch so that
+ * it fits in 32 bits, leaving the rest of the word for state flags.
+ */
+class CacheEntryHeader {
+public:
+    static const uint32_t NO_DEADLINE = 0xFFFFFFFFu;
+
+    enum Flags {
+        PINNED      = 0x1,  //entry is never expired
+        REFRESHING  = 0x2   //a reload of the entry is in flight
+    };
+
+public:
+    explicit CacheEntryHeader(uint32_t deadline = NO_DEADLINE, uint32_t flags = 0) :
+        _deadline(deadline),
+        _flags(flags)
+    {}
+
+    uint32_t deadline() const {
+        return _deadline;
+    }
+
+    uint32_t flags() const {
+        return _flags;
+    }
+
+    bool hasFlags(uint32_t flags) const {
+        return ((_flags & flags) == flags);
+    }
+
+private:
+    uint32_t _deadline;
+    uint32_t _flags;
+};
+
+
+/**
+ * A value stored in a timed cache, with its bookkeeping header.
+ *
+ * Earlier versions stored the absolute insertion time and exposed it through
+ * timestamp(). That accessor has been removed: the header only holds a
+ * deadline in seconds relative to the owning cache's epoch (or, in
+ * GENERATIONAL_EXPIRATION mode, the generation the entry was written in),
+ * from which the insertion time can not be recovered. Use header() to inspect
+ * expiration state. CacheValue is also no longer polymorphic.
+ */
 template <typename T>
 class CacheValue {
 public:
-    CacheValue(const T& val) :
-        _timestamp((boost::posix_time::microsec_clock::universal_time() -
-                    boost::posix_time::from_time_t(0)).total_seconds()),
+    CacheValue(const T& val, const CacheEntryHeader& header = CacheEntryHeader()) :
+        _header(header),
         _value(val)
     {}
 
-    virtual ~CacheValue() {}
-
+    /*
+     * Headers are compared first as they are a single integer compare;
+     * values are only compared when the headers tie.
+     */
     bool operator==(const CacheValue& rhs) const {
-        return ((this->_timestamp == rhs._timestamp) &&
+        return ((this->_header.deadline() == rhs._header.deadline()) &&
                 (this->_value == rhs._value));
     }
 
     bool operator<(const CacheValue& rhs) const {
-        return ((this->_value == rhs._value) ?
-                (this->_timestamp < rhs._timestamp) :
-                (this->_value < rhs._value));
+        return ((this->_header.deadline() == rhs._header.deadline()) ?
+                (this->_value < rhs._value) :
+                (this->_header.deadline() < rhs._header.deadline()));
     }
 
-    const uint64_t& timestamp() const {
-        return _timestamp;
+    const CacheEntryHeader& header() const {
+        return _header;
+    }
+
+    uint32_t deadline() const {
+        return _header.deadline();
     }
 
     const T& value() const {
         return _value;
     }
 private:
-    uint64_t _timestamp;
+    CacheEntryHeader _header;
     T _value;
 };
 
+static_assert(sizeof(CacheEntryHeader) == 8, "CacheEntryHeader must pack into a single 64-bit word");
+static_assert(!std::is_polymorphic<CacheValue<uint64_t> >::value, "CacheValue must not carry a vtable");
+static_assert(sizeof(CacheValue<uint64_t>) == 16, "CacheValue<uint64_t> must be header plus payload only");
+static_assert(sizeof(CacheValue<void*>) == sizeof(CacheEntryHeader) + sizeof(void*),
+              "CacheValue<void*> must be header plus payload only");
+
 
 /**
  * A cache implementation with support for timed expiration of entries
+ *
+ * Two expiration modes are supported:
+ *  - PER_ENTRY_EXPIRATION: each entry carries its own deadline (the default)
+ *  - GENERATIONAL_EXPIRATION: for caches where every entry has the same TTL.
+ *    Entries are tagged with the time slice (generation) they were written in
+ *    and their keys are recorded in a bucket for that generation. When a
+ *    generation ages out, the next get or put drops its bucket and removes
+ *    the entries of every key in it, regardless of where they sit in the least
+ *    recently used order. That costs time proportional to the bucket size,
+ *    which amortizes to constant time per put.
+ *    Expiration jitter and early expiration do not apply in this mode.
+ *
+ * Time is read from the Clock type (see CacheClock.h). Tests and simulations
+ * can use ManualClock and drive it through clock(). Locking and eviction
+ * policies are passed through to LRUCache.
  */
-template <typename K, typename V>
-class LRUTimedCache : public virtual LRUCache<K, CacheValue<V> > {
+template <typename K, typename V,
+          typename Clock = SystemClock,
+          typename LockingPolicy = RecursiveMutexLocking,
+          typename EvictionPolicy = LruEviction>
+class LRUTimedCache : public LRUCache<K, CacheValue<V>, LockingPolicy, EvictionPolicy> {
 public:
     typedef typename std::pair<K, V> Entry;
     typedef typename std::set<V, std::less<V>, std::allocator<V> > ValueSet;
     typedef typename std::set<Entry, std::less<Entry>, std::allocator<Entry> > Set;
 
     typedef CacheValue<V> CacheValueType;
+    typedef Clock ClockType;
 
 
 protected:
-    typedef LRUCache<K, CacheValueType > TimedCacheType;
+    typedef LRUCache<K, CacheValueType, LockingPolicy, EvictionPolicy> TimedCacheType;
+    typedef typename TimedCacheType::Mutex Mutex;
     typedef typename TimedCacheType::Entry TCEntry;
     typedef typename TimedCacheType::Set TCSet;
     typedef typename TimedCacheType::KeyViewConstRef TCKey;
@@ -92,6 +185,12 @@ protected:
 public:
     static const unsigned int DEFAULT_MAX_CAPACITY = 1000;
     static const uint64_t DEFAULT_CACHE_EXPIRATION = 43200L;
+    static const unsigned int DEFAULT_GENERATIONS = 8;
+
+    enum ExpirationMode {
+        PER_ENTRY_EXPIRATION,
+        GENERATIONAL_EXPIRATION
+    };
 
 public:
     /**
@@ -103,7 +202,40 @@ public:
     LRUTimedCache(unsigned int capacity = DEFAULT_MAX_CAPACITY,
                   uint64_t expiration = DEFAULT_CACHE_EXPIRATION)
         : TimedCacheType(capacity),
-          _expiration(expiration) {}
+          _clock(),
+          _mode(PER_ENTRY_EXPIRATION),
+          _epoch(currentTime()),
+          _expiration(expiration),
+          _generations(0),
+          _generationSpan(0),
+          _jitter(0),
+          _earlyExpirationWindow(0),
+          _earlyExpirationBeta(1.0),
+          _random(std::random_device()()) {}
+
+    /**
+     * Create a new LRUTimedCache with the specified expiration mode
+     *
+     * @param capacity
+     * @param expiration in seconds
+     * @param mode of expiration
+     * @param generations number of time slices the expiration is divided into when
+     *        using GENERATIONAL_EXPIRATION. Entries live between (generations - 1) and
+     *        generations slices, so more generations give a more precise expiration
+     */
+    LRUTimedCache(unsigned int capacity, uint64_t expiration, ExpirationMode mode,
+                  unsigned int generations = DEFAULT_GENERATIONS)
+        : TimedCacheType(capacity),
+          _clock(),
+          _mode(mode),
+          _epoch(currentTime()),
+          _expiration(expiration),
+          _generations(std::max(generations, 1u)),
+          _generationSpan(std::max<uint64_t>((expiration + _generations - 1) / _generations, 1)),
+          _jitter(0),
+          _earlyExpirationWindow(0),
+          _earlyExpirationBeta(1.0),
+          _random(std::random_device()()) {}
 
     virtual ~LRUTimedCache() {}
 
@@ -123,6 +255,66 @@ public:
         return _expiration;
     }
 
+    /**
+     * Return the clock the cache reads time from
+     */
+    Clock& clock() {
+        return _clock;
+    }
+
+    /**
+     * Return the configured expiration mode for the cache
+     */
+    ExpirationMode expirationMode() const {
+        return _mode;
+    }
+
+    /**
+     * Spread the expiration of entries that are written together. Each entry put
+     * afterwards is given a TTL drawn uniformly from [expiration - jitter, expiration].
+     *
+     * @param jitter in seconds. Clamped so that entries live at least one second
+     */
+    void setExpirationJitter(uint64_t jitter) {
+        _jitter = (jitter < _expiration) ? jitter : (_expiration ? _expiration - 1 : 0);
+    }
+
+    /**
+     * Return the configured expiration jitter for the cache
+     *
+     * @return duration in seconds
+     */
+    uint64_t expirationJitter() const {
+        return _jitter;
+    }
+
+    /**
+     * Enable probabilistic early expiration (XFetch). A lookup treats an entry as
+     * expired when
+     *
+     *     now - window * beta * ln(rand()) >= deadline
+     *
+     * so that readers of entries written together reload them at different times
+     * within roughly the last 'window' seconds of their lifetime.
+     *
+     * @param window in seconds, typically the time it takes to reload an entry.
+     *        Zero disables early expiration
+     * @param beta scales the window. Values above 1.0 favour earlier reloads
+     */
+    void setEarlyExpiration(uint64_t window, double beta = 1.0) {
+        std::lock_guard<Mutex> lock(_randomMutex);
+        _earlyExpirationBeta = beta;
+        _earlyExpirationWindow = window;
+    }
+
+    /**
+     * Seed the generator used for expiration jitter and early expiration
+     */
+    void setRandomSeed(uint32_t seed) {
+        std::lock_guard<Mutex> lock(_randomMutex);
+        _random.seed(seed);
+    }
+
     /**
      * Return a set of key and values from the cache
      *
@@ -152,6 +344,16 @@ public:
         return set;
     }
 
+    /**
+     * Removes all of the mappings from the cache, and the generation buckets
+     * that name them. Also called through an LRUCache reference.
+     */
+    virtual void clear() {
+        std::lock_guard<Mutex> lock(TimedCacheType::mutex());
+        TimedCacheType::clear();
+        _buckets.clear();
+    }
+
     /**
      * Get objects out of the cache by key
      *
@@ -160,11 +362,33 @@ public:
      */
     boost::optional<V> get(const K& key) {
         boost::optional<V> retVal;
+
+        if (GENERATIONAL_EXPIRATION == _mode) {
+            //synchronized
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
+            uint64_t current = generation();
+            dropGenerations(current);
+
+            /*
+             * Dropping the buckets removes aged out entries; the generation of
+             * the entry found is still checked in case one was missed
+             */
+            boost::optional<CacheValueType> cacheValue = TimedCacheType::get(key);
+            if (cacheValue) {
+                if (expired(cacheValue.get().header(), current)) {
+                    TimedCacheType::remove(key, cacheValue.get());
+                } else {
+                    retVal = cacheValue.get().value();
+                }
+            }
+            return retVal;
+        }
+
         boost::optional<CacheValueType> cacheValue = TimedCacheType::get(key);
 
         if (cacheValue) {
             CacheValueType value = cacheValue.get();
-            if (expired(value.timestamp())) {
+            if (expired(value.header())) {
                 /*
                  * Key exists in cache, but is expired.
                  * Expunge entry from cache and return empty value
@@ -189,13 +413,13 @@ public:
         boost::optional<K> key;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(TimedCacheType::mutex());
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
 
             TCSet expiredEntries;
 
             BOOST_FOREACH(TCValue entry, TimedCacheType::cache().right) {
                 if (entry.first.value() == lookupValue) {
-                    if (expired(entry.first.timestamp())) {
+                    if (expired(entry.first.header())) {
                         //entry has expired
                         expiredEntries.insert(TCEntry(entry.second, entry.first));
                     } else {
@@ -229,7 +453,7 @@ public:
 
         if (cacheValue) {
             CacheValueType value = cacheValue.get();
-            if (!expired(value.timestamp())) {
+            if (!expired(value.header())) {
                 /*
                  * Key exists in cache and has not expired.
                  */
@@ -247,7 +471,71 @@ public:
      * @param value to store
      */
     void put(const K& key, const V& value) {
-        TimedCacheType::put(key, CacheValueType(value));
+        put(key, value, 0);
+    }
+
+    /**
+     * Put objects in the cache with the specified entry flags
+     *
+     * @param key to store
+     * @param value to store
+     * @param flags CacheEntryHeader::Flags to set on the entry
+     */
+    void put(const K& key, const V& value, uint32_t flags) {
+        if (GENERATIONAL_EXPIRATION != _mode) {
+            TimedCacheType::put(key, CacheValueType(value, CacheEntryHeader(deadline(), flags)));
+            return;
+        }
+
+        {//synchronized
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
+            TimedCacheType::put(key, newEntry(key, value, flags));
+        }
+    }
+
+    /**
+     * Put objects in the cache only if the key has no live value. Expired values
+     * of the key are expunged first. The lookup and the insert happen under one
+     * lock, so callers racing to fill the same key leave a single entry.
+     *
+     * @param key to store
+     * @param value to store
+     * @param flags CacheEntryHeader::Flags to set on the entry
+     *
+     * @return boost optional set with the live value already mapped to the key,
+     *         or empty if the specified value was inserted
+     */
+    boost::optional<V> putIfAbsent(const K& key, const V& value, uint32_t flags = 0) {
+        boost::optional<V> existing;
+
+        {//synchronized
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
+            expunge(key);
+
+            boost::optional<CacheValueType> cacheValue = TimedCacheType::get(key);
+            if (cacheValue) {
+                existing = cacheValue.get().value();
+            } else {
+                TimedCacheType::put(key, newEntry(key, value, flags));
+            }
+        }
+
+        return existing;
+    }
+
+    /**
+     * Put objects in the cache replacing every value mapped to the key, so that
+     * afterwards the key maps to the specified value only
+     *
+     * @param key to store
+     * @param value to store
+     * @param flags CacheEntryHeader::Flags to set on the entry
+     */
+    void replace(const K& key, const V& value, uint32_t flags = 0) {
+        {//synchronized
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
+            TimedCacheType::replace(key, newEntry(key, value, flags));
+        }
     }
 
     /**
@@ -273,7 +561,7 @@ public:
         std::list<CacheValueType> entriesRemoved;
 
         {//synchronized
-            std::lock_guard<std::recursive_mutex> lock(TimedCacheType::mutex());
+            std::lock_guard<Mutex> lock(TimedCacheType::mutex());
             TCSet entriesToRemove;
 
             TCKeyItrRange range = TimedCacheType::cache().left.equal_range(key);
@@ -295,19 +583,239 @@ public:
     }
 
 protected:
-    virtual bool expired(uint64_t timestamp) const {
+    bool expired(const CacheEntryHeader& header) const {
+        if ((CacheEntryHeader::NO_DEADLINE == header.deadline()) ||
+            header.hasFlags(CacheEntryHeader::PINNED)) {
+            return false;
+        }
+
+        if (GENERATIONAL_EXPIRATION == _mode) {
+            return expired(header, generation());
+        }
+
+        uint64_t now = elapsed();
+        if (now >= header.deadline()) {
+            return true;
+        }
+
+        /*
+         * Early expiration is off by default; only take the generator lock when
+         * it has been enabled
+         */
+        uint64_t window = _earlyExpirationWindow;
+        if (0 == window) {
+            return false;
+        }
+
+        std::lock_guard<Mutex> lock(_randomMutex);
+        //std::generate_canonical returns [0, 1); flip it so the log is finite
+        double random = 1.0 - std::generate_canonical<double, 32>(_random);
+        double early = -std::log(random) * _earlyExpirationBeta * static_cast<double>(window);
+        return (early >= static_cast<double>(header.deadline() - now));
+    }
+
+    /**
+     * Returns the number of seconds since the epoch of this cache
+     */
+    uint64_t elapsed() const {
+        uint64_t now = currentTime();
+        return (now > _epoch) ? (now - _epoch) : 0;
+    }
+
+    /**
+     * Returns the deadline for an entry inserted now, relative to the cache epoch
+     */
+    uint32_t deadline() const {
         if (0 == _expiration) {
+            return CacheEntryHeader::NO_DEADLINE;
+        }
+
+        uint64_t ttl = _expiration;
+        uint64_t jitter = _jitter;
+        if (jitter) {
+            std::lock_guard<Mutex> lock(_randomMutex);
+            ttl -= std::uniform_int_distribution<uint64_t>(0, jitter)(_random);
+        }
+
+        uint64_t deadline = elapsed() + ttl;
+        return (deadline < CacheEntryHeader::NO_DEADLINE) ? static_cast<uint32_t>(deadline)
+                                                          : (CacheEntryHeader::NO_DEADLINE - 1);
+    }
+
+    /**
+     * Returns true if an entry has aged out given the current generation.
+     * Only meaningful in GENERATIONAL_EXPIRATION mode, where the header deadline
+     * holds the generation the entry was written in.
+     */
+    bool expired(const CacheEntryHeader& header, uint64_t currentGeneration) const {
+        if (0 == _expiration || header.hasFlags(CacheEntryHeader::PINNED)) {
             return false;
         }
 
-        return (boost::posix_time::microsec_clock::universal_time() >=
-                (boost::posix_time::from_time_t(timestamp) + ::boost::posix_time::seconds(_expiration)));
+        return (static_cast<uint64_t>(header.deadline()) + _generations <= currentGeneration);
+    }
+
+    /**
+     * Build the cache value for an entry written now. In GENERATIONAL_EXPIRATION
+     * mode this drops aged out generations and records the key in the current
+     * one, so it must be called with the cache mutex held.
+     */
+    CacheValueType newEntry(const K& key, const V& value, uint32_t flags) {
+        if (GENERATIONAL_EXPIRATION != _mode) {
+            return CacheValueType(value, CacheEntryHeader(deadline(), flags));
+        }
+
+        uint64_t current = generation();
+
+        /*
+         * Drop aged out generations first so that a full cache evicts an
+         * expired entry rather than the least recently used live one
+         */
+        dropGenerations(current);
+
+        uint32_t tag = static_cast<uint32_t>(std::min<uint64_t>(current, CacheEntryHeader::NO_DEADLINE - 1));
+        if (_expiration && !(flags & CacheEntryHeader::PINNED)) {
+            recordGeneration(key, tag);
+        }
+
+        return CacheValueType(value, CacheEntryHeader(tag, flags));
+    }
+
+    /**
+     * Remove the expired values of a key. Must be called with the cache mutex held.
+     */
+    void expunge(const K& key) {
+        if (GENERATIONAL_EXPIRATION == _mode) {
+            dropGenerations(generation());
+            return;
+        }
+
+        TCKeyItrRange range = TimedCacheType::cache().left.equal_range(key);
+        for (TCKeyItr itr = range.first; itr != range.second;) {
+            TCKeyItr entry = itr++;
+            if (expired(entry->second.header())) {
+                TimedCacheType::cache().left.erase(entry);
+            }
+        }
+    }
+
+    /**
+     * Drop the buckets of every generation that has aged out, removing their
+     * entries from the cache. Must be called with the cache mutex held.
+     *
+     * A bucket may name keys that have since been removed, evicted or written
+     * again in a later generation; only the aged out entries of a key are removed.
+     */
+    void dropGenerations(uint64_t currentGeneration) {
+        while (!_buckets.empty() && (_buckets.front().generation + _generations <= currentGeneration)) {
+            BOOST_FOREACH(const K& key, _buckets.front().keys) {
+                TCKeyItrRange range = TimedCacheType::cache().left.equal_range(key);
+                for (TCKeyItr itr = range.first; itr != range.second;) {
+                    TCKeyItr entry = itr++;
+                    if (expired(entry->second.header(), currentGeneration)) {
+                        TimedCacheType::cache().left.erase(entry);
+                    }
+                }
+            }
+            _buckets.pop_front();
+        }
+    }
+
+    /**
+     * Record a key in the bucket of the generation it is being written in.
+     * Must be called with the cache mutex held, before the entry is inserted.
+     */
+    void recordGeneration(const K& key, uint32_t tag) {
+        if (_buckets.empty() || (_buckets.back().generation != tag)) {
+            _buckets.push_back(GenerationBucket(tag));
+        }
+
+        GenerationBucket& bucket = _buckets.back();
+
+        /*
+         * Keys that are removed and written again within a generation are
+         * recorded each time. Keep the bucket bounded by the cache capacity.
+         * This runs before the key being written is recorded, as that key has
+         * no entry in the cache yet and would be filtered out.
+         */
+        unsigned int capacity = TimedCacheType::capacity();
+        if (capacity && (bucket.keys.size() >= 2 * static_cast<size_t>(capacity))) {
+            std::vector<K> live;
+            BOOST_FOREACH(const K& bucketKey, bucket.keys) {
+                if (hasGeneration(bucketKey, tag)) {
+                    live.push_back(bucketKey);
+                }
+            }
+            bucket.keys.swap(live);
+        }
+
+        if (!hasGeneration(key, tag)) {
+            bucket.keys.push_back(key);
+        }
     }
 
+    /**
+     * Returns true if the key has an entry written in the given generation
+     */
+    bool hasGeneration(const K& key, uint32_t tag) {
+        TCKeyItrRange range = TimedCacheType::cache().left.equal_range(key);
+        for (TCKeyItr itr = range.first; itr != range.second; itr++) {
+            if (itr->second.deadline() == tag) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Returns the current generation, relative to the cache epoch
+     */
+    uint64_t generation() const {
+        return elapsed() / _generationSpan;
+    }
+
+    uint64_t currentTime() const {
+        return _clock.now();
+    }
+
+private:
+    //keys written during one generation
+    struct GenerationBucket {
+        explicit GenerationBucket(uint64_t gen) : generation(gen) {}
+
+        uint64_t generation;
+        std::vector<K> keys;
+    };
+
 private:
+    Clock _clock;
+    ExpirationMode _mode;
+    uint64_t _epoch;
     uint64_t _expiration;
+
+    //generational expiration; entries live for _generations spans of _generationSpan seconds
+    unsigned int _generations;
+    uint64_t _generationSpan;
+    std::deque<GenerationBucket> _buckets; //oldest first; guarded by the cache mutex
+
+    /*
+     * expiration spreading; the generator and beta are guarded by _randomMutex.
+     * jitter and window are read without the lock so that lookups and puts only
+     * take it when spreading is enabled
+     */
+    std::atomic<uint64_t> _jitter;
+    std::atomic<uint64_t> _earlyExpirationWindow;
+    double _earlyExpirationBeta;
+    mutable std::mt19937 _random;
+    mutable Mutex _randomMutex;
 };
 
+/**
+ * An LRUTimedCache for use from a single thread, without any locking
+ */
+template <typename K, typename V, typename Clock = SystemClock>
+using UnsynchronizedLRUTimedCache = LRUTimedCache<K, V, Clock, NoLocking, LruEviction>;
+
 }}} // namespace ::ezbake::common::lrucache 
 
 #endif /* EZBAKE_COMMON_LRUCACHE_LRUTIMEDCACHE_H_ */
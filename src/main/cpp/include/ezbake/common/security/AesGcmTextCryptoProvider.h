@@ -0,0 +1,117 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AesGcmTextCryptoProvider.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_AESGCMTEXTCRYPTOPROVIDER_H_
+#define EZBAKE_COMMON_SECURITY_AESGCMTEXTCRYPTOPROVIDER_H_
+
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Encrypts text with a shared secret using AES-256-GCM.
+ *
+ * The key is derived from the secret once at construction with PBKDF2-HMAC-SHA256.
+ * Encrypted messages are written as
+ *
+ *     VERSION_HEADER + Base64(nonce | ciphertext | tag)
+ *
+ * with the header authenticated along with the ciphertext. Messages without the
+ * header are treated as legacy PBE-MD5-DES messages and decrypted the way
+ * SharedSecretTextCryptoProvider does, so existing ciphertexts stay readable
+ * while new ones use the faster cipher.
+ */
+class AesGcmTextCryptoProvider : public TextCryptoProvider {
+public:
+    static const std::string VERSION_HEADER;
+    static const unsigned int KEY_LENGTH = 32;
+    static const unsigned int NONCE_LENGTH = 12;
+    static const unsigned int TAG_LENGTH = 16;
+    static const int PBKDF2_ITERATIONS = 100000;
+
+public:
+    /**
+     * @param secret the shared secret to derive the keys from
+     *
+     * @throws SecurityException if a key could not be derived
+     */
+    AesGcmTextCryptoProvider(const std::string& secret);
+
+    virtual ~AesGcmTextCryptoProvider();
+
+    /**
+     * Encrypts a message with AES-256-GCM and a random nonce.
+     *
+     * @param message the message to be encrypted
+     *
+     * @throws SecurityException if an error occurs while encrypting the message
+     */
+    virtual std::string encrypt(const std::string& message) const;
+
+    /**
+     * Decrypt a message and return a plain text message. Both AES-256-GCM and
+     * legacy PBE-MD5-DES messages are accepted.
+     *
+     * @param encryptedMessage the message to be decrypted
+     *
+     * @throws SecurityException if the message is not authentic or an error occurs
+     *         while trying to decrypt the message.
+     */
+    virtual std::string decrypt(const std::string& encryptedMessage) const;
+
+    virtual size_t maxEncryptedSize(size_t length) const {
+        return VERSION_HEADER.length() + 4 * ((NONCE_LENGTH + length + TAG_LENGTH + 2) / 3);
+    }
+
+    virtual size_t maxDecryptedSize(size_t length) const {
+        return 3 * ((length + 3) / 4);
+    }
+
+    /**
+     * Encrypts a message into a caller owned buffer
+     *
+     * @see TextCryptoProvider::encryptTo
+     */
+    virtual size_t encryptTo(boost::string_ref message, char* out, size_t capacity) const;
+
+    /**
+     * Decrypts an AES-256-GCM or legacy PBE-MD5-DES message into a caller owned buffer
+     *
+     * @see TextCryptoProvider::decryptTo
+     */
+    virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const;
+
+    /**
+     * Returns true if the message carries the AES-256-GCM version header
+     */
+    static bool isVersioned(boost::string_ref encryptedMessage);
+
+private:
+    static const std::string SALT;
+
+    unsigned char _key[KEY_LENGTH];
+    SharedSecretTextCryptoProvider _legacy;
+};
+
+}}} // namespace ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_AESGCMTEXTCRYPTOPROVIDER_H_ */
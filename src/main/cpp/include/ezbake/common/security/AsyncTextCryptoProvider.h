@@ -0,0 +1,189 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AsyncTextCryptoProvider.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_ASYNCTEXTCRYPTOPROVIDER_H_
+#define EZBAKE_COMMON_SECURITY_ASYNCTEXTCRYPTOPROVIDER_H_
+
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+
+#if __cplusplus >= 202002L
+#include <coroutine>
+#endif
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Runs the operations of a TextCryptoProvider on dedicated worker threads, so
+ * the threads issuing requests never do crypto work themselves.
+ *
+ * Requests wait in a bounded queue. Each worker takes every waiting request of
+ * the same kind, up to maxBatch of them, and hands them to the provider's
+ * encryptBatch()/decryptBatch() in one call, so requests that arrive together
+ * share the provider's key schedule and per-thread contexts. When the queue is
+ * full, new requests fail at once rather than block the caller.
+ */
+class AsyncTextCryptoProvider : boost::noncopyable {
+public:
+    static const size_t DEFAULT_THREADS = 1;
+    static const size_t DEFAULT_QUEUE_CAPACITY = 4096;
+    static const size_t DEFAULT_MAX_BATCH = 64;
+
+    /**
+     * Receives the result of a request: the output on success, or the error
+     */
+    typedef std::function<void (std::string* result, std::exception_ptr error)> Completion;
+
+public:
+    /**
+     * @param provider      the provider doing the work
+     * @param threads       number of worker threads, at least one is started
+     * @param queueCapacity maximum number of requests waiting for a worker
+     * @param maxBatch      maximum number of requests handed to the provider at once
+     */
+    explicit AsyncTextCryptoProvider(const boost::shared_ptr<TextCryptoProvider>& provider,
+            size_t threads = DEFAULT_THREADS, size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+            size_t maxBatch = DEFAULT_MAX_BATCH);
+
+    /**
+     * Completes the waiting requests and joins the workers
+     */
+    ~AsyncTextCryptoProvider();
+
+    /**
+     * Encrypts a message on a worker thread
+     *
+     * @return future for the encrypted message. It holds a SecurityException if
+     *         the queue is full or the provider failed to encrypt the message.
+     */
+    std::future<std::string> encrypt(const std::string& message);
+
+    /**
+     * Decrypts a message on a worker thread
+     *
+     * @return future for the plain text message. It holds a SecurityException if
+     *         the queue is full or the provider failed to decrypt the message.
+     */
+    std::future<std::string> decrypt(const std::string& encryptedMessage);
+
+    /**
+     * Encrypts a message on a worker thread, invoking completion on that
+     * thread when done, or on the calling thread if the queue is full.
+     */
+    void encrypt(const std::string& message, const Completion& completion);
+
+    /**
+     * Decrypts a message on a worker thread, invoking completion on that
+     * thread when done, or on the calling thread if the queue is full.
+     */
+    void decrypt(const std::string& encryptedMessage, const Completion& completion);
+
+    /**
+     * Returns the number of requests waiting for a worker
+     */
+    size_t pending() const;
+
+#if __cplusplus >= 202002L
+    /**
+     * Awaitable result of a request. The awaiting coroutine resumes on the
+     * worker thread that completed the request.
+     */
+    class Awaitable {
+    public:
+        Awaitable(AsyncTextCryptoProvider& provider, bool decrypt, std::string input) :
+            _provider(provider), _decrypt(decrypt), _input(std::move(input)) {}
+
+        bool await_ready() const noexcept {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) {
+            Completion completion = [this, handle](std::string* result, std::exception_ptr error) {
+                if (result) {
+                    _result = std::move(*result);
+                }
+                _error = error;
+                handle.resume();
+            };
+            _provider.submit(_decrypt, std::move(_input), completion);
+        }
+
+        std::string await_resume() {
+            if (_error) {
+                std::rethrow_exception(_error);
+            }
+            return std::move(_result);
+        }
+
+    private:
+        AsyncTextCryptoProvider& _provider;
+        bool _decrypt;
+        std::string _input;
+        std::string _result;
+        std::exception_ptr _error;
+    };
+
+    Awaitable encryptAsync(std::string message) {
+        return Awaitable(*this, false, std::move(message));
+    }
+
+    Awaitable decryptAsync(std::string encryptedMessage) {
+        return Awaitable(*this, true, std::move(encryptedMessage));
+    }
+#endif
+
+private:
+    struct Request {
+        bool decrypt;
+        std::string input;
+        Completion completion;
+    };
+
+    void submit(bool decrypt, std::string input, const Completion& completion);
+
+    void run();
+
+    void process(std::vector<Request>& batch);
+
+private:
+    boost::shared_ptr<TextCryptoProvider> _provider;
+    const size_t _queueCapacity;
+    const size_t _maxBatch;
+
+    std::deque<Request> _requests;
+    mutable std::mutex _mutex;
+    std::condition_variable _available;
+    bool _stopping;
+    std::vector<std::thread> _workers;
+};
+
+}}} // namespace ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_ASYNCTEXTCRYPTOPROVIDER_H_ */
@@ -0,0 +1,176 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64Stream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_BASE64STREAM_H_
+#define EZBAKE_COMMON_SECURITY_BASE64STREAM_H_
+
+#include <cstddef>
+#include <functional>
+#include <sys/uio.h>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Receives output of the streaming encoders and encryptors as it is produced
+ */
+typedef std::function<void (const char* data, size_t length)> OutputSink;
+
+
+/**
+ * Incremental Base64 encoder producing the same text as Base64Util::encode().
+ *
+ * Data is fed in chunks of any size through update() and completed with
+ * finish(). Only a partial 3 byte group is carried between calls, so memory
+ * use depends on the chunk size and not the message size.
+ */
+class Base64Encoder : boost::noncopyable {
+public:
+    //largest output of finish()
+    static const size_t MAX_FINISH_LENGTH = 4;
+
+    /**
+     * Returns the largest output of an update() of the specified length
+     */
+    static size_t maxUpdateLength(size_t length) {
+        return 4 * ((length + 2) / 3);
+    }
+
+public:
+    Base64Encoder();
+
+    /**
+     * Encodes a chunk into a caller provided buffer
+     *
+     * @param data      chunk to encode
+     * @param length    length of the chunk
+     * @param out       buffer of at least maxUpdateLength(length) bytes
+     *
+     * @return number of bytes written to out
+     */
+    size_t update(const char* data, size_t length, char* out);
+
+    /**
+     * Encodes a chunk, passing output to the sink
+     */
+    void update(const char* data, size_t length, const OutputSink& sink);
+
+    /**
+     * Encodes a scattered chunk, passing output to the sink
+     */
+    void update(const struct iovec* buffers, size_t count, const OutputSink& sink);
+
+    /**
+     * Encodes and pads the remaining bytes into a caller provided buffer, and
+     * readies the encoder for a new message
+     *
+     * @param out       buffer of at least MAX_FINISH_LENGTH bytes
+     *
+     * @return number of bytes written to out
+     */
+    size_t finish(char* out);
+
+    /**
+     * Encodes and pads the remaining bytes, passing output to the sink
+     */
+    void finish(const OutputSink& sink);
+
+private:
+    unsigned char _carry[3];
+    size_t _carryLength;
+};
+
+
+/**
+ * Incremental Base64 decoder accepting padded Base64 text in chunks of any
+ * size. Only a partial 4 character group is carried between calls.
+ *
+ * Input is validated as it arrives. After an error the decoder must be reset
+ * before it is used again.
+ */
+class Base64Decoder : boost::noncopyable {
+public:
+    /**
+     * Returns the largest output of an update() of the specified length
+     */
+    static size_t maxUpdateLength(size_t length) {
+        return 3 * ((length + 3) / 4);
+    }
+
+public:
+    Base64Decoder();
+
+    /**
+     * Decodes a chunk into a caller provided buffer
+     *
+     * @param data      encoded chunk
+     * @param length    length of the chunk
+     * @param out       buffer of at least maxUpdateLength(length) bytes
+     *
+     * @return number of bytes written to out
+     *
+     * @throws StringEncryptorException naming the offset in the message of the first invalid character
+     */
+    size_t update(const char* data, size_t length, char* out);
+
+    /**
+     * Decodes a chunk, passing output to the sink
+     */
+    void update(const char* data, size_t length, const OutputSink& sink);
+
+    /**
+     * Decodes a scattered chunk, passing output to the sink
+     */
+    void update(const struct iovec* buffers, size_t count, const OutputSink& sink);
+
+    /**
+     * Checks the input ended on a complete group, and readies the decoder
+     * for a new message
+     *
+     * @throws StringEncryptorException if the input is truncated
+     */
+    void finish();
+
+    /**
+     * Returns the number of characters held until their group is complete
+     */
+    size_t pending() const {
+        return _carryLength;
+    }
+
+    /**
+     * Discards any partial input
+     */
+    void reset();
+
+private:
+    size_t decode(const char* data, size_t length, unsigned char* out);
+
+private:
+    char _carry[4];
+    size_t _carryLength;
+    size_t _offset;
+    bool _padded;
+};
+
+}}} // ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_BASE64STREAM_H_ */
@@ -22,12 +22,17 @@
 #ifndef EZBAKE_COMMON_SECURITY_BASE64UTIL_H_
 #define EZBAKE_COMMON_SECURITY_BASE64UTIL_H_
 
+#include <cstddef>
 #include <string>
+#include <boost/utility/string_ref.hpp>
 
 namespace ezbake { namespace common { namespace security {
 
 class Base64Util {
 public:
+    //returned by the caller buffer decoders for input that is not valid Base64
+    static const size_t npos = static_cast<size_t>(-1);
+
     static std::string encode(const std::string& serializedData) {
         return encode(serializedData.data(), static_cast<int>(serializedData.length()));
     }
@@ -46,6 +51,114 @@ public:
     static std::string encode(const char* data, int length);
     static std::string decode(const char* data, int length);
 
+    /**
+     * Returns the exact length of the encoding of length bytes
+     */
+    static size_t encodedLength(size_t length) {
+        return 4 * ((length + 2) / 3);
+    }
+
+    /**
+     * Returns the largest length decoded from length characters
+     */
+    static size_t decodedMaxLength(size_t length) {
+        return 3 * ((length + 3) / 4);
+    }
+
+    /**
+     * Encodes data into a caller provided buffer of encodedLength(length)
+     * bytes. The data may already sit at the end of that buffer, so a
+     * message can be encoded in place.
+     *
+     * @return number of bytes written to out
+     */
+    static size_t encodeTo(const char* data, size_t length, char* out);
+
+    /**
+     * Appends the encoding of data to out
+     */
+    static void appendEncoded(const char* data, size_t length, std::string& out);
+
+    static void appendEncoded(const std::string& data, std::string& out) {
+        appendEncoded(data.data(), data.length(), out);
+    }
+
+    /**
+     * Decodes data into a caller provided buffer of decodedMaxLength(length)
+     * bytes, which may start at data to decode in place. Accepts the same
+     * input as decode().
+     *
+     * @return number of bytes written to out, or npos if data is not valid Base64
+     */
+    static size_t decodeTo(const char* data, size_t length, char* out);
+
+    /**
+     * Strictly decodes padded Base64 with no whitespace into a caller provided
+     * buffer of decodedMaxLength(length) bytes, which may start at data.
+     * Validation and decoding are a single pass.
+     *
+     * @param errorOffset   set to the offset of the first invalid character, or
+     *                      to length if there is none and the input is valid or truncated
+     *
+     * @return number of bytes written to out, or npos if data is not valid Base64
+     */
+    static size_t decodeStrict(const char* data, size_t length, char* out, size_t& errorOffset);
+
+    /**
+     * Decodes data in place, over the start of the encoded text
+     *
+     * @return decoded length, or npos if data is not valid Base64
+     */
+    static size_t decodeInPlace(char* data, size_t length) {
+        return decodeTo(data, length, data);
+    }
+
+    /**
+     * Appends the decoding of data to out
+     *
+     * @return false if data is not valid Base64, with out left unchanged
+     */
+    static bool appendDecoded(const char* data, size_t length, std::string& out);
+
+    static bool appendDecoded(const std::string& data, std::string& out) {
+        return appendDecoded(data.data(), data.length(), out);
+    }
+
+    /**
+     * Location of one item of a batch in the arena
+     */
+    struct Span {
+        size_t offset;
+        size_t length;
+    };
+
+    /**
+     * Encodes count items, appending all encodings contiguously to the arena
+     * so a batch costs at most one allocation. Items are staged together so
+     * the vector kernels run across item boundaries, which keeps their lanes
+     * full when each item is only a few dozen bytes.
+     *
+     * @param items     array of count items
+     * @param count     number of items
+     * @param arena     receives the encodings after its existing contents
+     * @param spans     receives the location of each encoding in the arena, at least count elements
+     */
+    static void encodeBatch(const boost::string_ref* items, size_t count, std::string& arena, Span* spans);
+
+    /**
+     * Decodes count items, appending all decodings contiguously to the arena.
+     * Accepts the same input as decodeStrict(). An item that is not valid
+     * Base64 takes no space in the arena and gets a span of length npos.
+     *
+     * @param items     array of count encoded items
+     * @param count     number of items
+     * @param arena     receives the decodings after its existing contents
+     * @param spans     receives the location of each decoding in the arena, at least count elements
+     *
+     * @return number of items that are not valid Base64
+     */
+    static size_t decodeBatch(const boost::string_ref* items, size_t count, std::string& arena, Span* spans);
+
 public:
     Base64Util();
 };
@@ -0,0 +1,112 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CachingTextCryptoProvider.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_CACHINGTEXTCRYPTOPROVIDER_H_
+#define EZBAKE_COMMON_SECURITY_CACHINGTEXTCRYPTOPROVIDER_H_
+
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <ezbake/common/security/SecureBuffer.h>
+#include <ezbake/common/lrucache/LRUTimedCache.h>
+#include <boost/shared_ptr.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Decorates a TextCryptoProvider, memoizing decrypted messages.
+ *
+ * Services decrypt the same few configuration values and credentials over and
+ * over; with this decorator only the first decrypt of a message reaches the
+ * wrapped provider until the entry expires or is evicted. Plaintexts are held
+ * in SecureBuffers, so they stay out of swap and are zeroed when the last
+ * reference to an evicted entry goes away. Failed decrypts are not cached.
+ *
+ * Encryption is passed straight through. The provider is safe to use from
+ * multiple threads if the wrapped provider is.
+ */
+class CachingTextCryptoProvider : public TextCryptoProvider {
+public:
+    static const unsigned int DEFAULT_CAPACITY = 256;
+    static const uint64_t DEFAULT_EXPIRATION = 600;
+
+public:
+    /**
+     * @param provider      the provider to decorate
+     * @param capacity      maximum number of decrypted messages to keep
+     * @param expiration    seconds a decrypted message is kept for
+     */
+    explicit CachingTextCryptoProvider(const boost::shared_ptr<TextCryptoProvider>& provider,
+            unsigned int capacity = DEFAULT_CAPACITY, uint64_t expiration = DEFAULT_EXPIRATION);
+
+    virtual ~CachingTextCryptoProvider() {}
+
+    virtual std::string encrypt(const std::string& message) const {
+        return _provider->encrypt(message);
+    }
+
+    /**
+     * Decrypts a message, returning the cached plaintext if the message was
+     * decrypted before.
+     *
+     * @see TextCryptoProvider::decrypt
+     */
+    virtual std::string decrypt(const std::string& encryptedMessage) const;
+
+    virtual size_t maxEncryptedSize(size_t length) const {
+        return _provider->maxEncryptedSize(length);
+    }
+
+    virtual size_t maxDecryptedSize(size_t length) const {
+        return _provider->maxDecryptedSize(length);
+    }
+
+    virtual size_t encryptTo(boost::string_ref message, char* out, size_t capacity) const {
+        return _provider->encryptTo(message, out, capacity);
+    }
+
+    /**
+     * Decrypts a message into a caller owned buffer, copying the cached
+     * plaintext if the message was decrypted before.
+     *
+     * @see TextCryptoProvider::decryptTo
+     */
+    virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const;
+
+    /**
+     * Drops every cached plaintext
+     */
+    void clear() const;
+
+private:
+    typedef boost::shared_ptr<const SecureBuffer> Plaintext;
+    typedef ::ezbake::common::lrucache::LRUTimedCache<std::string, Plaintext> Cache;
+
+    Plaintext lookup(boost::string_ref encryptedMessage) const;
+
+    Plaintext decryptAndCache(boost::string_ref encryptedMessage) const;
+
+private:
+    boost::shared_ptr<TextCryptoProvider> _provider;
+    mutable Cache _cache;
+};
+
+}}} // namespace ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_CACHINGTEXTCRYPTOPROVIDER_H_ */
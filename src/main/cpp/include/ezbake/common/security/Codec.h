@@ -0,0 +1,282 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Codec.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_CODEC_H_
+#define EZBAKE_COMMON_SECURITY_CODEC_H_
+
+#include <cstddef>
+#include <string>
+#include <sys/uio.h>
+#include <boost/utility.hpp>
+#include <ezbake/common/security/Base64Stream.h>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Binary to text encodings of RFC 4648 behind a single interface, backed by
+ * the same vectorized kernels as Base64Util.
+ *
+ * The caller buffer methods mirror those of Base64Util and never throw;
+ * Encoder and Decoder mirror Base64Encoder and Base64Decoder. Decoding is
+ * strict: no whitespace, and padding wherever the encoding requires it.
+ */
+class Codec : boost::noncopyable {
+public:
+    //returned by the caller buffer decoders for input that is not valid in the encoding
+    static const size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * Standard padded Base64, as produced by Base64Util
+     */
+    static const Codec& base64();
+
+    /**
+     * URL and filename safe Base64, unpadded. Decoding accepts the final group
+     * with or without padding.
+     */
+    static const Codec& base64Url();
+
+    /**
+     * Padded Base32
+     */
+    static const Codec& base32();
+
+    /**
+     * Lower case hex. Decoding accepts either case.
+     */
+    static const Codec& hex();
+
+    /**
+     * Decodes data in one encoding and appends it to out in another. Data is
+     * processed in slices on the stack, so no buffer of the whole decoded
+     * message is allocated.
+     *
+     * @param errorOffset   set to the offset of the first invalid character, or
+     *                      to length if there is none and the input is valid or truncated
+     *
+     * @return false if data is not valid in the source encoding, with out left unchanged
+     */
+    static bool transcode(const Codec& from, const Codec& to, const char* data, size_t length,
+            std::string& out, size_t& errorOffset);
+
+public:
+    /**
+     * Incremental encoder producing the same text as encodeTo(). Only a
+     * partial group is carried between calls.
+     */
+    class Encoder : boost::noncopyable {
+    public:
+        explicit Encoder(const Codec& codec);
+
+        /**
+         * Returns the largest output of an update() of the specified length
+         */
+        size_t maxUpdateLength(size_t length) const;
+
+        /**
+         * Returns the largest output of finish()
+         */
+        size_t maxFinishLength() const;
+
+        /**
+         * Encodes a chunk into a caller provided buffer of at least
+         * maxUpdateLength(length) bytes
+         *
+         * @return number of bytes written to out
+         */
+        size_t update(const char* data, size_t length, char* out);
+
+        /**
+         * Encodes a chunk, passing output to the sink
+         */
+        void update(const char* data, size_t length, const OutputSink& sink);
+
+        /**
+         * Encodes a scattered chunk, passing output to the sink
+         */
+        void update(const struct iovec* buffers, size_t count, const OutputSink& sink);
+
+        /**
+         * Encodes the remaining bytes into a caller provided buffer of at
+         * least maxFinishLength() bytes, and readies the encoder for a new message
+         *
+         * @return number of bytes written to out
+         */
+        size_t finish(char* out);
+
+        /**
+         * Encodes the remaining bytes, passing output to the sink
+         */
+        void finish(const OutputSink& sink);
+
+    private:
+        const Codec& _codec;
+        unsigned char _carry[8];
+        size_t _carryLength;
+    };
+
+    /**
+     * Incremental decoder accepting the same input as decodeTo() in chunks of
+     * any size. Only a partial group is carried between calls.
+     *
+     * After an error the decoder must be reset before it is used again.
+     */
+    class Decoder : boost::noncopyable {
+    public:
+        explicit Decoder(const Codec& codec);
+
+        /**
+         * Returns the largest output of an update() of the specified length
+         */
+        size_t maxUpdateLength(size_t length) const;
+
+        /**
+         * Returns the largest output of finish()
+         */
+        size_t maxFinishLength() const;
+
+        /**
+         * Decodes a chunk into a caller provided buffer of at least
+         * maxUpdateLength(length) bytes
+         *
+         * @return number of bytes written to out
+         *
+         * @throws StringEncryptorException naming the offset in the message of the first invalid character
+         */
+        size_t update(const char* data, size_t length, char* out);
+
+        /**
+         * Decodes a chunk, passing output to the sink
+         */
+        void update(const char* data, size_t length, const OutputSink& sink);
+
+        /**
+         * Decodes a scattered chunk, passing output to the sink
+         */
+        void update(const struct iovec* buffers, size_t count, const OutputSink& sink);
+
+        /**
+         * Decodes an unpadded final group, if the encoding allows one, into a
+         * caller provided buffer of at least maxFinishLength() bytes, and
+         * readies the decoder for a new message
+         *
+         * @return number of bytes written to out
+         *
+         * @throws StringEncryptorException if the input is truncated
+         */
+        size_t finish(char* out);
+
+        /**
+         * Decodes an unpadded final group, passing output to the sink
+         */
+        void finish(const OutputSink& sink);
+
+        /**
+         * Returns the number of characters held until their group is complete
+         */
+        size_t pending() const {
+            return _carryLength;
+        }
+
+        /**
+         * Discards any partial input
+         */
+        void reset();
+
+    private:
+        size_t decode(const char* data, size_t length, unsigned char* out);
+
+    private:
+        const Codec& _codec;
+        char _carry[8];
+        size_t _carryLength;
+        size_t _offset;
+        bool _padded;
+    };
+
+public:
+    /**
+     * Returns the name of the encoding, such as "Base64URL"
+     */
+    const char* name() const;
+
+    /**
+     * Returns the exact length of the encoding of length bytes
+     */
+    size_t encodedLength(size_t length) const;
+
+    /**
+     * Returns the largest length decoded from length characters
+     */
+    size_t decodedMaxLength(size_t length) const;
+
+    /**
+     * Encodes data into a caller provided buffer of encodedLength(length)
+     * bytes, which must not overlap data
+     *
+     * @return number of bytes written to out
+     */
+    size_t encodeTo(const char* data, size_t length, char* out) const;
+
+    std::string encode(const std::string& data) const;
+
+    /**
+     * Appends the encoding of data to out
+     */
+    void appendEncoded(const char* data, size_t length, std::string& out) const;
+
+    /**
+     * Decodes data into a caller provided buffer of decodedMaxLength(length)
+     * bytes, which may start at data to decode in place. Validation and
+     * decoding are a single pass.
+     *
+     * @param errorOffset   set to the offset of the first invalid character, or
+     *                      to length if there is none and the input is valid or truncated
+     *
+     * @return number of bytes written to out, or npos if data is not valid in this encoding
+     */
+    size_t decodeTo(const char* data, size_t length, char* out, size_t& errorOffset) const;
+
+    /**
+     * Appends the decoding of data to out
+     *
+     * @return false if data is not valid in this encoding, with out left unchanged
+     */
+    bool appendDecoded(const char* data, size_t length, std::string& out) const;
+
+    bool appendDecoded(const std::string& data, std::string& out) const {
+        return appendDecoded(data.data(), data.length(), out);
+    }
+
+private:
+    struct Scheme;
+
+    explicit Codec(const Scheme& scheme);
+
+    size_t decode(const char* data, size_t length, unsigned char* out, bool& padded, size_t& errorOffset) const;
+
+private:
+    const Scheme& _scheme;
+};
+
+}}} // ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_CODEC_H_ */
@@ -0,0 +1,109 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CryptoRuntime.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_CRYPTORUNTIME_H_
+#define EZBAKE_COMMON_SECURITY_CRYPTORUNTIME_H_
+
+#include <openssl/evp.h>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Algorithms shared by the security layer, fetched once per process.
+ *
+ * On OpenSSL 3 the algorithms are explicitly fetched from the default
+ * provider, so EVP calls skip the implicit fetch they do for EVP_md5() and
+ * friends on every init.
+ */
+class CryptoRuntime : boost::noncopyable {
+public:
+    /**
+     * Returns the process wide runtime
+     */
+    static const CryptoRuntime& instance();
+
+public:
+    const EVP_MD* md5() const {
+        return _md5;
+    }
+
+    const EVP_MD* sha256() const {
+        return _sha256;
+    }
+
+    const EVP_CIPHER* aes256Gcm() const {
+        return _aes256Gcm;
+    }
+
+private:
+    CryptoRuntime();
+    ~CryptoRuntime();
+
+private:
+    EVP_MD* _md5;
+    EVP_MD* _sha256;
+    EVP_CIPHER* _aes256Gcm;
+};
+
+
+/**
+ * Borrows the calling thread's cached digest context for the lifetime of the
+ * object, and resets it on release. A nested borrow on the same thread gets a
+ * context of its own.
+ */
+class DigestContext : boost::noncopyable {
+public:
+    DigestContext();
+    ~DigestContext();
+
+    EVP_MD_CTX* get() const {
+        return _ctx;
+    }
+
+private:
+    EVP_MD_CTX* _ctx;
+    bool _cached;
+};
+
+
+/**
+ * Borrows the calling thread's cached cipher context for the lifetime of the
+ * object, and resets it on release so no key material is left behind. A
+ * nested borrow on the same thread gets a context of its own.
+ */
+class CipherContext : boost::noncopyable {
+public:
+    CipherContext();
+    ~CipherContext();
+
+    EVP_CIPHER_CTX* get() const {
+        return _ctx;
+    }
+
+private:
+    EVP_CIPHER_CTX* _ctx;
+    bool _cached;
+};
+
+}}} // ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_CRYPTORUNTIME_H_ */
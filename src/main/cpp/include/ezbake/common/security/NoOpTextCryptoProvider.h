@@ -23,6 +23,8 @@
 #define EZBAKE_COMMON_SECURITY_NOOPTEXTCRYPTOPROVIDER_H_
 
 #include <ezbake/common/security/TextCryptoProvider.h>
+#include <cstring>
+#include <boost/throw_exception.hpp>
 
 namespace ezbake { namespace common { namespace security {
 
@@ -56,6 +58,39 @@ public:
     inline virtual std::string decrypt(const std::string& encryptedMessage) const {
         return encryptedMessage;
     }
+
+    inline virtual size_t maxEncryptedSize(size_t length) const {
+        return length;
+    }
+
+    inline virtual size_t maxDecryptedSize(size_t length) const {
+        return length;
+    }
+
+    /**
+     * This is a no op so just copy the message into the buffer
+     */
+    inline virtual size_t encryptTo(boost::string_ref message, char* out, size_t capacity) const {
+        return copy(message, out, capacity);
+    }
+
+    /**
+     * This is a no op so just copy the "encrypted" message into the buffer
+     */
+    inline virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const {
+        return copy(encryptedMessage, out, capacity);
+    }
+
+private:
+    static size_t copy(boost::string_ref message, char* out, size_t capacity) {
+        if (capacity < message.size()) {
+            BOOST_THROW_EXCEPTION(SecurityException("Output buffer is too small"));
+        }
+        if (!message.empty()) {
+            std::memcpy(out, message.data(), message.size());
+        }
+        return message.size();
+    }
 };
 
 }}} // namespace ezbake::common::security
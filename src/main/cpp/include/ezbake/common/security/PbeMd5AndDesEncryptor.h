@@ -23,6 +23,9 @@
 #define EZBAKE_COMMON_SECURITY_PBEMD5ANDDES_H_
 
 #include <ezbake/common/security/PbeStringEncryptor.h>
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/utility/string_ref.hpp>
 #include <openssl/des.h>
 
 namespace ezbake { namespace common { namespace security {
@@ -37,6 +40,7 @@ public:
 
 public:
     static const unsigned int ALGO_BLOCK_SIZE;
+    static const unsigned int KEY_CACHE_CAPACITY;
 
 
 public:
@@ -66,6 +70,108 @@ public:
     static std::string decrypt(const std::string& encryptedtext, const std::string& password,
             const std::string salt="do provide default", long iterations=1000);
 
+    /**
+     * Returns an encrypted string using a previously generated key.
+     * The key is not modified and may be shared across threads.
+     *
+     * @param plaintext     the message to be encrypted
+     * @param key           key generated for the password, salt and iterations
+     *
+     * @throws StringEncryptorException if an error occurs while encrypting the message
+     */
+    static std::string encrypt(const std::string& plaintext, const PbeMd5AndDesKey& key);
+
+    /**
+     * Returns a decrypted string using a previously generated key.
+     * The key is not modified and may be shared across threads.
+     *
+     * @param encryptedtext the message to be decrypted
+     * @param key           key generated for the password, salt and iterations
+     *
+     * @throws StringEncryptorException if an error occurs while decrypting the message
+     */
+    static std::string decrypt(const std::string& encryptedtext, const PbeMd5AndDesKey& key);
+
+    /**
+     * Returns the exact encrypted length of a message of the specified length
+     */
+    static size_t encryptedLength(size_t plaintextLength) {
+        return 4 * (((plaintextLength / 8 + 1) * 8 + 2) / 3);
+    }
+
+    /**
+     * Returns the largest decrypted length of an encrypted message of the specified length
+     */
+    static size_t maxDecryptedLength(size_t encryptedLength) {
+        return 3 * ((encryptedLength + 3) / 4);
+    }
+
+    /**
+     * Encrypts a message into a caller provided buffer using a previously
+     * generated key. Performs no heap allocation.
+     *
+     * @param plaintext     the message to be encrypted
+     * @param key           key generated for the password, salt and iterations
+     * @param out           buffer of at least encryptedLength(plaintext.size()) bytes
+     *
+     * @return number of bytes written to out
+     */
+    static size_t encrypt(boost::string_ref plaintext, const PbeMd5AndDesKey& key, char* out);
+
+    /**
+     * Decrypts a message into a caller provided buffer using a previously
+     * generated key. Performs no heap allocation.
+     *
+     * @param encryptedtext the message to be decrypted
+     * @param key           key generated for the password, salt and iterations
+     * @param out           buffer of at least maxDecryptedLength(encryptedtext.size()) bytes
+     *
+     * @return number of bytes written to out
+     *
+     * @throws StringEncryptorException if the message is malformed
+     */
+    static size_t decrypt(boost::string_ref encryptedtext, const PbeMd5AndDesKey& key, char* out);
+
+    /**
+     * Encrypts count messages with a previously generated key. A message that
+     * fails to encrypt leaves its result empty and is reported in the returned
+     * errors.
+     *
+     * @param plaintexts    array of count messages
+     * @param results       receives the encrypted messages, at least count elements
+     * @param count         number of messages
+     * @param key           key generated for the password, salt and iterations
+     *
+     * @return errors for the failed messages, ordered by index
+     */
+    static BatchErrors encryptBatch(const std::string* plaintexts, std::string* results, size_t count,
+            const PbeMd5AndDesKey& key);
+
+    /**
+     * Decrypts count messages with a previously generated key, giving the same
+     * results as count calls to decrypt(). The blocks of all messages are
+     * decrypted together, several at a time in SIMD lanes when the CPU
+     * supports AVX2. A message that fails to decrypt leaves its result empty
+     * and is reported in the returned errors.
+     *
+     * @param encryptedtexts    array of count messages
+     * @param results           receives the decrypted messages, at least count elements
+     * @param count             number of messages
+     * @param key               key generated for the password, salt and iterations
+     *
+     * @return errors for the failed messages, ordered by index
+     */
+    static BatchErrors decryptBatch(const std::string* encryptedtexts, std::string* results, size_t count,
+            const PbeMd5AndDesKey& key);
+
+    /**
+     * Decrypts count messages, message i with *keys[i]
+     *
+     * @see decryptBatch(const std::string*, std::string*, size_t, const PbeMd5AndDesKey&)
+     */
+    static BatchErrors decryptBatch(const std::string* encryptedtexts, std::string* results, size_t count,
+            const PbeMd5AndDesKey* const* keys);
+
     /**
      * Generates a Pbe Md5 & Des Key
      *
@@ -77,8 +183,44 @@ public:
      */
     static PbeMd5AndDesKey generateKey(const std::string& password, const std::string salt, long iterations);
 
+    /**
+     * Generates Pbe Md5 & Des Keys for count (password, salt) pairs, giving the
+     * same keys as count calls to generateKey(). The MD5 iterations of up to
+     * eight keys run together in SIMD lanes when the CPU supports AVX2.
+     *
+     * @param passwords     array of count passwords
+     * @param salts         array of count salts
+     * @param count         number of keys to generate
+     * @param iterations    number of passes in randomizing each password.
+     * @param keys          receives the generated keys, at least count elements
+     *
+     * @throws StringEncryptorException if an error occurs while generating the keys
+     */
+    static void generateKeys(const std::string* passwords, const std::string* salts, size_t count,
+            long iterations, PbeMd5AndDesKey* keys);
+
+    /**
+     * Returns a Pbe Md5 & Des Key from the process wide cache of derived keys,
+     * generating and caching it if needed. Cache entries are looked up by a
+     * digest of the password, salt and iterations, never by the password itself.
+     *
+     * @param password      required password for the key
+     * @param salt          password salt.
+     * @param iterations    number of passes in randomizing the password.
+     *
+     * @throws StringEncryptorException if an error occurs while generating the key
+     */
+    static boost::shared_ptr<const PbeMd5AndDesKey> getKey(const std::string& password, const std::string& salt,
+            long iterations);
+
 private:
+    static std::string generateKeyDigest(const std::string& password, const std::string& salt, long iterations);
+
     static std::string generateDataHash(const std::string& data, const std::string salt, long iterations);
+
+    static void hashSeed(const std::string& data, const std::string& salt, unsigned char* result);
+
+    static void makeKey(const unsigned char* hash, PbeMd5AndDesKey& key);
 };
 
 }}} // ezbake::common::security
@@ -0,0 +1,170 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * PbeMd5AndDesStream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_PBEMD5ANDDESSTREAM_H_
+#define EZBAKE_COMMON_SECURITY_PBEMD5ANDDESSTREAM_H_
+
+#include <cstddef>
+#include <ezbake/common/security/Base64Stream.h>
+#include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Incremental PBE-MD5-DES encryptor producing the same Base64 text as
+ * PbeMd5AndDesEncryptor::encrypt().
+ *
+ * Plaintext is fed in chunks of any size through update() and completed with
+ * final(). Only a partial DES block and a partial Base64 quantum are carried
+ * between calls, so memory use does not depend on the message size.
+ */
+class PbeMd5AndDesStreamEncryptor : boost::noncopyable {
+public:
+    //largest output of final()
+    static const size_t MAX_FINAL_LENGTH = 16;
+
+    /**
+     * Returns the largest output of an update() of the specified length
+     */
+    static size_t maxUpdateLength(size_t length) {
+        return 4 * ((length + 9) / 3);
+    }
+
+public:
+    explicit PbeMd5AndDesStreamEncryptor(const PbeMd5AndDesEncryptor::PbeMd5AndDesKey& key);
+    ~PbeMd5AndDesStreamEncryptor();
+
+    /**
+     * Encrypts a chunk of plaintext into a caller provided buffer
+     *
+     * @param data      plaintext chunk
+     * @param length    length of the chunk
+     * @param out       buffer of at least maxUpdateLength(length) bytes
+     *
+     * @return number of bytes written to out
+     */
+    size_t update(const char* data, size_t length, char* out);
+
+    /**
+     * Encrypts a chunk of plaintext, passing output to the sink
+     */
+    void update(const char* data, size_t length, const OutputSink& sink);
+
+    /**
+     * Pads and encrypts the remaining plaintext into a caller provided buffer
+     *
+     * @param out       buffer of at least MAX_FINAL_LENGTH bytes
+     *
+     * @return number of bytes written to out
+     *
+     * @throws StringEncryptorException if the encryptor was already finalized
+     */
+    size_t final(char* out);
+
+    /**
+     * Pads and encrypts the remaining plaintext, passing output to the sink
+     */
+    void final(const OutputSink& sink);
+
+private:
+    size_t encryptBlocks(const unsigned char* data, size_t length, char* out);
+
+private:
+    PbeMd5AndDesEncryptor::PbeMd5AndDesKey _key;
+    unsigned char _pending[8];
+    size_t _pendingLength;
+    Base64Encoder _encoder;
+    bool _finalized;
+};
+
+
+/**
+ * Incremental PBE-MD5-DES decryptor accepting the Base64 text produced by
+ * PbeMd5AndDesEncryptor::encrypt() or PbeMd5AndDesStreamEncryptor.
+ *
+ * The last cipher block is held back until final() since it carries the padding,
+ * so memory use does not depend on the message size.
+ */
+class PbeMd5AndDesStreamDecryptor : boost::noncopyable {
+public:
+    //largest output of final()
+    static const size_t MAX_FINAL_LENGTH = 8;
+
+    /**
+     * Returns the largest output of an update() of the specified length
+     */
+    static size_t maxUpdateLength(size_t length) {
+        return 3 * ((length + 3) / 4) + 8;
+    }
+
+public:
+    explicit PbeMd5AndDesStreamDecryptor(const PbeMd5AndDesEncryptor::PbeMd5AndDesKey& key);
+    ~PbeMd5AndDesStreamDecryptor();
+
+    /**
+     * Decrypts a chunk of Base64 encoded ciphertext into a caller provided buffer
+     *
+     * @param data      encoded chunk
+     * @param length    length of the chunk
+     * @param out       buffer of at least maxUpdateLength(length) bytes
+     *
+     * @return number of bytes written to out
+     *
+     * @throws StringEncryptorException if the chunk is not valid Base64
+     */
+    size_t update(const char* data, size_t length, char* out);
+
+    /**
+     * Decrypts a chunk of Base64 encoded ciphertext, passing output to the sink
+     */
+    void update(const char* data, size_t length, const OutputSink& sink);
+
+    /**
+     * Decrypts the last block and strips the padding
+     *
+     * @param out       buffer of at least MAX_FINAL_LENGTH bytes
+     *
+     * @return number of bytes written to out
+     *
+     * @throws StringEncryptorException if the ciphertext is truncated or the padding is invalid
+     */
+    size_t final(char* out);
+
+    /**
+     * Decrypts the last block and strips the padding, passing output to the sink
+     */
+    void final(const OutputSink& sink);
+
+private:
+    size_t decryptBlocks(const unsigned char* data, size_t length, char* out);
+
+private:
+    PbeMd5AndDesEncryptor::PbeMd5AndDesKey _key;
+    unsigned char _pending[8];
+    size_t _pendingLength;
+    Base64Decoder _decoder;
+    bool _finalized;
+};
+
+}}} // ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_PBEMD5ANDDESSTREAM_H_ */
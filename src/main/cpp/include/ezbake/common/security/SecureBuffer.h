@@ -0,0 +1,84 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * SecureBuffer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_SECUREBUFFER_H_
+#define EZBAKE_COMMON_SECURITY_SECUREBUFFER_H_
+
+#include <cstddef>
+#include <string>
+#include <boost/utility.hpp>
+#include <boost/utility/string_ref.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+/**
+ * Immutable copy of sensitive data held in memory that is locked against
+ * swapping where the platform allows it, excluded from core dumps, and
+ * zeroed before it is released.
+ *
+ * When the OpenSSL secure heap has been initialized the data lives there,
+ * otherwise in pages of its own locked with mlock(). Locking is best effort;
+ * isLocked() reports whether it succeeded.
+ */
+class SecureBuffer : boost::noncopyable {
+public:
+    /**
+     * Copies data into secure memory
+     *
+     * @throws std::bad_alloc if memory could not be allocated
+     */
+    explicit SecureBuffer(boost::string_ref data);
+
+    /**
+     * Zeroes and releases the memory
+     */
+    ~SecureBuffer();
+
+    const char* data() const {
+        return _data;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool isLocked() const {
+        return _locked;
+    }
+
+    /**
+     * Returns a copy of the data. The copy is ordinary memory.
+     */
+    std::string str() const {
+        return std::string(_data, _size);
+    }
+
+private:
+    char* _data;
+    size_t _size;
+    size_t _allocated;
+    bool _secureHeap;
+    bool _locked;
+};
+
+}}} // ezbake::common::security
+
+#endif /* EZBAKE_COMMON_SECURITY_SECUREBUFFER_H_ */
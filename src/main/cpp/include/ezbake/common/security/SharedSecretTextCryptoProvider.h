@@ -23,14 +23,38 @@
 #define EZBAKE_COMMON_SECURITY_SHAREDSECRETTEXTCRYPTOPROVIDER_H_
 
 #include <ezbake/common/security/TextCryptoProvider.h>
+#include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
+#include <ezbake/common/utils/ThreadPool.h>
 #include <boost/shared_ptr.hpp>
 
 namespace ezbake { namespace common { namespace security {
 
+/**
+ * Encrypts text with a shared secret using PBE with MD5 and DES.
+ *
+ * The key is derived once at construction, and the provider is safe to use
+ * from multiple threads. Batches are spread across a thread pool, sharing the
+ * derived key schedule.
+ */
 class SharedSecretTextCryptoProvider : public TextCryptoProvider {
 public:
-    SharedSecretTextCryptoProvider(const std::string& secret)
-        : _password(secret) {}
+    /**
+     * Batches larger than one chunk run on the process wide thread pool, which
+     * is only started by the first such batch.
+     *
+     * @param secret the shared secret to derive the key from
+     *
+     * @throws SecurityException if the key could not be derived
+     */
+    SharedSecretTextCryptoProvider(const std::string& secret);
+
+    /**
+     * @param secret the shared secret to derive the key from
+     * @param pool   thread pool to run batches on, must outlive the provider
+     *
+     * @throws SecurityException if the key could not be derived
+     */
+    SharedSecretTextCryptoProvider(const std::string& secret, ::ezbake::common::utils::ThreadPool& pool);
 
     virtual ~SharedSecretTextCryptoProvider() {}
 
@@ -52,10 +76,58 @@ public:
      */
     virtual std::string decrypt(const std::string& encryptedMessage) const;
 
+    virtual size_t maxEncryptedSize(size_t length) const {
+        return PbeMd5AndDesEncryptor::encryptedLength(length);
+    }
+
+    virtual size_t maxDecryptedSize(size_t length) const {
+        return PbeMd5AndDesEncryptor::maxDecryptedLength(length);
+    }
+
+    /**
+     * Encrypts a message into a caller owned buffer, without heap allocation
+     *
+     * @see TextCryptoProvider::encryptTo
+     */
+    virtual size_t encryptTo(boost::string_ref message, char* out, size_t capacity) const;
+
+    /**
+     * Decrypts a message into a caller owned buffer, without heap allocation
+     *
+     * @see TextCryptoProvider::decryptTo
+     */
+    virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const;
+
+    /**
+     * Encrypts a batch of messages on the thread pool
+     *
+     * @see TextCryptoProvider::encryptBatch
+     */
+    virtual BatchErrors encryptBatch(const std::string* messages, std::string* results, size_t count) const;
+
+    /**
+     * Decrypts a batch of messages on the thread pool
+     *
+     * @see TextCryptoProvider::decryptBatch
+     */
+    virtual BatchErrors decryptBatch(const std::string* encryptedMessages, std::string* results, size_t count) const;
+
+private:
+    typedef BatchErrors (*Transform)(const std::string*, std::string*, size_t,
+            const PbeMd5AndDesEncryptor::PbeMd5AndDesKey&);
+
+    BatchErrors transformBatch(Transform transform, const char* errorPrefix, const std::string* inputs,
+            std::string* results, size_t count) const;
+
 private:
     static const std::string SALT;
+    static const long ITERATIONS = 1000;
+
+    //messages handed to a worker at a time
+    static const size_t BATCH_GRAIN = 256;
 
-    std::string _password;
+    boost::shared_ptr<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey> _key;
+    ::ezbake::common::utils::ThreadPool* _pool; //NULL until a pool is injected
 };
 
 }}} // namespace ezbake::common::security
@@ -22,7 +22,13 @@
 #ifndef EZBAKE_COMMON_SECURITY_TEXTCRYPTOPROVIDER_H_
 #define EZBAKE_COMMON_SECURITY_TEXTCRYPTOPROVIDER_H_
 
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <boost/throw_exception.hpp>
+#include <boost/utility/string_ref.hpp>
 
 namespace ezbake { namespace common { namespace security {
 
@@ -37,7 +43,31 @@ public:
 
 
 
+/**
+ * Failure of a single item of a batch operation
+ */
+struct BatchItemError {
+    BatchItemError(size_t index, const std::string& message) : index(index), message(message) {}
+
+    //position of the failed item in the batch
+    size_t index;
+
+    //description of the failure
+    std::string message;
+};
+
+typedef std::vector<BatchItemError> BatchErrors;
+
+
+
 class TextCryptoProvider {
+public:
+    /**
+     * Returned by maxEncryptedSize and maxDecryptedSize when a provider can not
+     * bound the size of its output in advance
+     */
+    static const size_t UNKNOWN_SIZE = static_cast<size_t>(-1);
+
 public:
     virtual ~TextCryptoProvider() {}
 
@@ -58,6 +88,163 @@ public:
      * @throws SecurityException if an error occurs while trying to decrypt the message.
      */
     virtual std::string decrypt(const std::string& encryptedMessage) const = 0;
+
+    /**
+     * Returns the largest encrypted size of a message of the specified length,
+     * or UNKNOWN_SIZE if the provider does not know it. Unknown by default.
+     */
+    virtual size_t maxEncryptedSize(size_t) const {
+        return UNKNOWN_SIZE;
+    }
+
+    /**
+     * Returns the largest decrypted size of an encrypted message of the specified
+     * length, or UNKNOWN_SIZE if the provider does not know it. Unknown by default.
+     */
+    virtual size_t maxDecryptedSize(size_t) const {
+        return UNKNOWN_SIZE;
+    }
+
+    /**
+     * Encrypts a message into a caller owned buffer. By default the message is
+     * copied and encrypted with encrypt(); providers override this to work
+     * without the copies.
+     *
+     * @param message   the message to be encrypted
+     * @param out       buffer receiving the encrypted message
+     * @param capacity  size of the buffer, at least maxEncryptedSize(message.size())
+     *                  when that is known
+     *
+     * @return number of bytes written to out
+     *
+     * @throws SecurityException if the buffer is too small or an error occurs while encrypting the message
+     */
+    virtual size_t encryptTo(boost::string_ref message, char* out, size_t capacity) const {
+        return copyTo(encrypt(std::string(message.data(), message.size())), out, capacity);
+    }
+
+    /**
+     * Decrypts a message into a caller owned buffer. By default the message is
+     * copied and decrypted with decrypt(); providers override this to work
+     * without the copies.
+     *
+     * @param encryptedMessage  the message to be decrypted
+     * @param out               buffer receiving the plain text message
+     * @param capacity          size of the buffer, at least maxDecryptedSize(encryptedMessage.size())
+     *                          when that is known
+     *
+     * @return number of bytes written to out
+     *
+     * @throws SecurityException if the buffer is too small or an error occurs while decrypting the message
+     */
+    virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const {
+        return copyTo(decrypt(std::string(encryptedMessage.data(), encryptedMessage.size())), out, capacity);
+    }
+
+    /**
+     * Encrypts a message and appends it to out. Allocates only if out lacks
+     * the capacity for maxEncryptedSize(message.size()) more bytes.
+     *
+     * @throws SecurityException if an error occurs while encrypting the message, out is left unchanged
+     */
+    void appendEncrypted(boost::string_ref message, std::string& out) const {
+        size_t length = maxEncryptedSize(message.size());
+        if (UNKNOWN_SIZE == length) {
+            out.append(encrypt(std::string(message.data(), message.size())));
+            return;
+        }
+
+        size_t offset = out.size();
+        out.resize(offset + length);
+        try {
+            out.resize(offset + encryptTo(message, &out[offset], out.size() - offset));
+        } catch (...) {
+            out.resize(offset);
+            throw;
+        }
+    }
+
+    /**
+     * Decrypts a message and appends it to out. Allocates only if out lacks
+     * the capacity for maxDecryptedSize(encryptedMessage.size()) more bytes.
+     *
+     * @throws SecurityException if an error occurs while decrypting the message, out is left unchanged
+     */
+    void appendDecrypted(boost::string_ref encryptedMessage, std::string& out) const {
+        size_t length = maxDecryptedSize(encryptedMessage.size());
+        if (UNKNOWN_SIZE == length) {
+            out.append(decrypt(std::string(encryptedMessage.data(), encryptedMessage.size())));
+            return;
+        }
+
+        size_t offset = out.size();
+        out.resize(offset + length);
+        try {
+            out.resize(offset + decryptTo(encryptedMessage, &out[offset], out.size() - offset));
+        } catch (...) {
+            out.resize(offset);
+            throw;
+        }
+    }
+
+    /**
+     * Encrypts count messages into the results array. A message that fails to
+     * encrypt leaves its result empty and is reported in the returned errors,
+     * the remaining messages are still encrypted.
+     *
+     * @param messages  the messages to be encrypted
+     * @param results   receives the encrypted messages, at least count elements
+     * @param count     number of messages
+     *
+     * @return errors for the failed messages, ordered by index
+     */
+    virtual BatchErrors encryptBatch(const std::string* messages, std::string* results, size_t count) const {
+        BatchErrors errors;
+        for (size_t i = 0; i < count; ++i) {
+            try {
+                results[i] = encrypt(messages[i]);
+            } catch (const std::exception& ex) {
+                results[i].clear();
+                errors.push_back(BatchItemError(i, ex.what()));
+            }
+        }
+        return errors;
+    }
+
+    /**
+     * Decrypts count messages into the results array. A message that fails to
+     * decrypt leaves its result empty and is reported in the returned errors,
+     * the remaining messages are still decrypted.
+     *
+     * @param encryptedMessages the messages to be decrypted
+     * @param results           receives the plain text messages, at least count elements
+     * @param count             number of messages
+     *
+     * @return errors for the failed messages, ordered by index
+     */
+    virtual BatchErrors decryptBatch(const std::string* encryptedMessages, std::string* results, size_t count) const {
+        BatchErrors errors;
+        for (size_t i = 0; i < count; ++i) {
+            try {
+                results[i] = decrypt(encryptedMessages[i]);
+            } catch (const std::exception& ex) {
+                results[i].clear();
+                errors.push_back(BatchItemError(i, ex.what()));
+            }
+        }
+        return errors;
+    }
+
+private:
+    static size_t copyTo(const std::string& result, char* out, size_t capacity) {
+        if (capacity < result.size()) {
+            BOOST_THROW_EXCEPTION(SecurityException("Output buffer is too small"));
+        }
+        if (!result.empty()) {
+            std::memcpy(out, result.data(), result.size());
+        }
+        return result.size();
+    }
 };
 
 }}} // namespace ezbake::common::security
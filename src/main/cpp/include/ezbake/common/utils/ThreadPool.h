@@ -0,0 +1,94 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_UTILS_THREADPOOL_H_
+#define EZBAKE_COMMON_UTILS_THREADPOOL_H_
+
+#include <cstddef>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/utility.hpp>
+
+namespace ezbake { namespace common { namespace utils {
+
+/**
+ * Fixed size pool of worker threads draining a shared task queue
+ */
+class ThreadPool : boost::noncopyable {
+public:
+    typedef std::function<void ()> Task;
+
+    /**
+     * Returns a process wide pool sized to the number of hardware threads
+     */
+    static ThreadPool& instance();
+
+public:
+    /**
+     * @param threads number of worker threads, at least one is started
+     */
+    explicit ThreadPool(size_t threads);
+
+    /**
+     * Runs the queued tasks and joins the workers
+     */
+    ~ThreadPool();
+
+    /**
+     * Returns the number of worker threads
+     */
+    size_t size() const {
+        return _workers.size();
+    }
+
+    /**
+     * Queues a task for execution on a worker thread. Exceptions thrown by
+     * the task are discarded.
+     */
+    void submit(const Task& task);
+
+    /**
+     * Splits the range [0, count) into chunks of at most grain indexes and
+     * invokes fn(begin, end) for each chunk, on the workers and the calling
+     * thread. Returns once every chunk has completed.
+     *
+     * @throws the first exception thrown by fn, after all chunks have completed
+     */
+    void parallelFor(size_t count, size_t grain, const std::function<void (size_t, size_t)>& fn);
+
+private:
+    void run();
+
+private:
+    std::vector<std::thread> _workers;
+    std::deque<Task> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _available;
+    bool _stopping;
+};
+
+}}} // namespace ::ezbake::common::utils
+
+#endif /* EZBAKE_COMMON_UTILS_THREADPOOL_H_ */
@@ -0,0 +1,159 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AesGcmTextCryptoProvider.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/AesGcmTextCryptoProvider.h>
+#include <ezbake/common/security/Base64Util.h>
+#include <ezbake/common/security/CryptoRuntime.h>
+#include "Base64Kernel.h"
+#include <cstring>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+const std::string AesGcmTextCryptoProvider::VERSION_HEADER = "$aesgcm1$";
+const std::string AesGcmTextCryptoProvider::SALT = "ezbake-common-aes-256-gcm";
+
+
+AesGcmTextCryptoProvider::AesGcmTextCryptoProvider(const std::string& secret)
+    : _legacy(secret) {
+    if (!PKCS5_PBKDF2_HMAC(secret.data(), static_cast<int>(secret.length()),
+                           reinterpret_cast<const unsigned char*>(SALT.data()), static_cast<int>(SALT.length()),
+                           PBKDF2_ITERATIONS, CryptoRuntime::instance().sha256(), KEY_LENGTH, _key)) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in deriving key"));
+    }
+}
+
+
+AesGcmTextCryptoProvider::~AesGcmTextCryptoProvider() {
+    OPENSSL_cleanse(_key, sizeof(_key));
+}
+
+
+bool AesGcmTextCryptoProvider::isVersioned(boost::string_ref encryptedMessage) {
+    return encryptedMessage.starts_with(VERSION_HEADER);
+}
+
+
+std::string AesGcmTextCryptoProvider::encrypt(const std::string& message) const {
+    std::string encrypted(maxEncryptedSize(message.length()), '\0');
+    encrypted.resize(encryptTo(message, &encrypted[0], encrypted.length()));
+    return encrypted;
+}
+
+
+std::string AesGcmTextCryptoProvider::decrypt(const std::string& encryptedMessage) const {
+    std::string decrypted(maxDecryptedSize(encryptedMessage.length()), '\0');
+    decrypted.resize(decryptTo(encryptedMessage, &decrypted[0], decrypted.length()));
+    return decrypted;
+}
+
+
+size_t AesGcmTextCryptoProvider::encryptTo(boost::string_ref message, char* out, size_t capacity) const {
+    size_t length = maxEncryptedSize(message.size());
+    if (capacity < length) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in encrypting string: output buffer is too small"));
+    }
+
+    //seal into the tail of the output, then Base64 encode it in place behind the header
+    size_t sealedLength = NONCE_LENGTH + message.size() + TAG_LENGTH;
+    unsigned char* sealed = reinterpret_cast<unsigned char*>(out) + (length - sealedLength);
+    unsigned char* nonce = sealed;
+    unsigned char* ciphertext = nonce + NONCE_LENGTH;
+    unsigned char* tag = ciphertext + message.size();
+    int written = 0;
+
+    if (RAND_bytes(nonce, NONCE_LENGTH) != 1) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in encrypting string: unable to generate nonce"));
+    }
+
+    CipherContext ctx;
+    if (!EVP_EncryptInit_ex(ctx.get(), CryptoRuntime::instance().aes256Gcm(), NULL, NULL, NULL) ||
+        !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, NONCE_LENGTH, NULL) ||
+        !EVP_EncryptInit_ex(ctx.get(), NULL, NULL, _key, nonce) ||
+        !EVP_EncryptUpdate(ctx.get(), NULL, &written,
+                           reinterpret_cast<const unsigned char*>(VERSION_HEADER.data()),
+                           static_cast<int>(VERSION_HEADER.length())) ||
+        !EVP_EncryptUpdate(ctx.get(), ciphertext, &written,
+                           reinterpret_cast<const unsigned char*>(message.data()),
+                           static_cast<int>(message.size())) ||
+        !EVP_EncryptFinal_ex(ctx.get(), ciphertext + written, &written) ||
+        !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, TAG_LENGTH, tag)) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in encrypting string"));
+    }
+
+    std::memcpy(out, VERSION_HEADER.data(), VERSION_HEADER.length());
+    return VERSION_HEADER.length() +
+            Base64Util::encodeTo(reinterpret_cast<const char*>(sealed), sealedLength, out + VERSION_HEADER.length());
+}
+
+
+size_t AesGcmTextCryptoProvider::decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const {
+    if (!isVersioned(encryptedMessage)) {
+        return _legacy.decryptTo(encryptedMessage, out, capacity);
+    }
+    if (capacity < maxDecryptedSize(encryptedMessage.size())) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in decrypting string: output buffer is too small"));
+    }
+
+    boost::string_ref encoded = encryptedMessage.substr(VERSION_HEADER.length());
+    unsigned char* sealed = reinterpret_cast<unsigned char*>(out);
+    size_t sealedLength = 0;
+    if (encoded.size() % 4 == 0) {
+        try {
+            bool padded = false;
+            sealedLength = base64kernel::decodeQuartets(encoded.data(), encoded.size(), sealed, padded);
+        } catch (const std::exception& ex) {
+            BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in decrypting string: ") + ex.what()));
+        }
+    }
+    if (sealedLength < NONCE_LENGTH + TAG_LENGTH) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in decrypting string: message is truncated"));
+    }
+
+    //move the ciphertext to the front of the buffer and decrypt it in place
+    unsigned char nonce[NONCE_LENGTH], tag[TAG_LENGTH];
+    int ciphertextLength = static_cast<int>(sealedLength - NONCE_LENGTH - TAG_LENGTH);
+    std::memcpy(nonce, sealed, NONCE_LENGTH);
+    std::memcpy(tag, sealed + NONCE_LENGTH + ciphertextLength, TAG_LENGTH);
+    std::memmove(sealed, sealed + NONCE_LENGTH, ciphertextLength);
+
+    int length = 0, finalLength = 0;
+    CipherContext ctx;
+    if (!EVP_DecryptInit_ex(ctx.get(), CryptoRuntime::instance().aes256Gcm(), NULL, NULL, NULL) ||
+        !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, NONCE_LENGTH, NULL) ||
+        !EVP_DecryptInit_ex(ctx.get(), NULL, NULL, _key, nonce) ||
+        !EVP_DecryptUpdate(ctx.get(), NULL, &length,
+                           reinterpret_cast<const unsigned char*>(VERSION_HEADER.data()),
+                           static_cast<int>(VERSION_HEADER.length())) ||
+        !EVP_DecryptUpdate(ctx.get(), sealed, &length, sealed, ciphertextLength) ||
+        !EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, TAG_LENGTH, tag) ||
+        EVP_DecryptFinal_ex(ctx.get(), sealed + length, &finalLength) <= 0) {
+        OPENSSL_cleanse(sealed, sealedLength);
+        BOOST_THROW_EXCEPTION(SecurityException("Error in decrypting string: message failed authentication"));
+    }
+
+    return static_cast<size_t>(length + finalLength);
+}
+
+}}} // namespace ezbake::common::security
@@ -0,0 +1,188 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AsyncTextCryptoProvider.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/AsyncTextCryptoProvider.h>
+#include <algorithm>
+#include <memory>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    //fulfills a promise from a completion
+    std::future<std::string> bindPromise(AsyncTextCryptoProvider::Completion& completion) {
+        std::shared_ptr<std::promise<std::string> > promise = std::make_shared<std::promise<std::string> >();
+        completion = [promise](std::string* result, std::exception_ptr error) {
+            if (error) {
+                promise->set_exception(error);
+            } else {
+                promise->set_value(std::move(*result));
+            }
+        };
+        return promise->get_future();
+    }
+}
+
+
+AsyncTextCryptoProvider::AsyncTextCryptoProvider(const boost::shared_ptr<TextCryptoProvider>& provider,
+        size_t threads, size_t queueCapacity, size_t maxBatch) :
+    _provider(provider),
+    _queueCapacity(std::max<size_t>(queueCapacity, 1)),
+    _maxBatch(std::max<size_t>(maxBatch, 1)),
+    _stopping(false)
+{
+    if (!_provider) {
+        BOOST_THROW_EXCEPTION(SecurityException("A provider to run requests on is required"));
+    }
+
+    threads = std::max<size_t>(threads, 1);
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::thread(&AsyncTextCryptoProvider::run, this));
+    }
+}
+
+
+AsyncTextCryptoProvider::~AsyncTextCryptoProvider() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _available.notify_all();
+    for (std::vector<std::thread>::iterator itr = _workers.begin(); itr != _workers.end(); ++itr) {
+        itr->join();
+    }
+}
+
+
+std::future<std::string> AsyncTextCryptoProvider::encrypt(const std::string& message) {
+    Completion completion;
+    std::future<std::string> result = bindPromise(completion);
+    submit(false, message, completion);
+    return result;
+}
+
+
+std::future<std::string> AsyncTextCryptoProvider::decrypt(const std::string& encryptedMessage) {
+    Completion completion;
+    std::future<std::string> result = bindPromise(completion);
+    submit(true, encryptedMessage, completion);
+    return result;
+}
+
+
+void AsyncTextCryptoProvider::encrypt(const std::string& message, const Completion& completion) {
+    submit(false, message, completion);
+}
+
+
+void AsyncTextCryptoProvider::decrypt(const std::string& encryptedMessage, const Completion& completion) {
+    submit(true, encryptedMessage, completion);
+}
+
+
+size_t AsyncTextCryptoProvider::pending() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _requests.size();
+}
+
+
+void AsyncTextCryptoProvider::submit(bool decrypt, std::string input, const Completion& completion) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_stopping && _requests.size() < _queueCapacity) {
+            Request request = {decrypt, std::move(input), completion};
+            _requests.push_back(std::move(request));
+            _available.notify_one();
+            return;
+        }
+    }
+
+    completion(NULL, std::make_exception_ptr(SecurityException("Crypto request queue is full")));
+}
+
+
+void AsyncTextCryptoProvider::run() {
+    std::vector<Request> batch;
+    batch.reserve(_maxBatch);
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _available.wait(lock, [this]() { return _stopping || !_requests.empty(); });
+            if (_requests.empty()) {
+                return;
+            }
+
+            //take the waiting requests of the same kind as the oldest one
+            bool decrypt = _requests.front().decrypt;
+            for (std::deque<Request>::iterator itr = _requests.begin();
+                 itr != _requests.end() && batch.size() < _maxBatch; ) {
+                if (itr->decrypt == decrypt) {
+                    batch.push_back(std::move(*itr));
+                    itr = _requests.erase(itr);
+                } else {
+                    ++itr;
+                }
+            }
+        }
+
+        process(batch);
+        batch.clear();
+    }
+}
+
+
+void AsyncTextCryptoProvider::process(std::vector<Request>& batch) {
+    std::vector<std::string> inputs(batch.size()), results(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        inputs[i].swap(batch[i].input);
+    }
+
+    BatchErrors errors;
+    try {
+        errors = batch.front().decrypt ?
+                _provider->decryptBatch(&inputs[0], &results[0], inputs.size()) :
+                _provider->encryptBatch(&inputs[0], &results[0], inputs.size());
+    } catch (...) {
+        std::exception_ptr error = std::current_exception();
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i].completion(NULL, error);
+        }
+        return;
+    }
+
+    BatchErrors::const_iterator error = errors.begin();
+    for (size_t i = 0; i < batch.size(); ++i) {
+        try {
+            if (error != errors.end() && error->index == i) {
+                batch[i].completion(NULL, std::make_exception_ptr(SecurityException(error->message)));
+                ++error;
+            } else {
+                batch[i].completion(&results[i], std::exception_ptr());
+            }
+        } catch (...) {
+            //completions report their own failures
+        }
+    }
+}
+
+}}} // namespace ezbake::common::security
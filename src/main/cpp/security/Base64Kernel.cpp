@@ -0,0 +1,590 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64Kernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "Base64Kernel.h"
+#include <algorithm>
+#include <cstring>
+#include <boost/lexical_cast.hpp>
+#include <boost/throw_exception.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EZBAKE_BASE64_SIMD 1
+//GCC 12 flags the deliberately undefined operand inside the VBMI intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#endif
+
+namespace ezbake { namespace common { namespace security { namespace base64kernel {
+
+/*
+ * The tables an alphabet needs: the characters, each ASCII character's value
+ * (0x80 outside the alphabet), and for the shuffle kernels the nibble classes
+ * and offsets described below.
+ */
+struct Alphabet {
+    unsigned char values[128] __attribute__((aligned(64)));
+    char characters[65] __attribute__((aligned(64)));
+    signed char encodeOffsets[16];
+    signed char lowClass[16];
+    signed char highClass[16];
+    signed char decodeOffsets[16];
+    char special;
+    signed char specialStep;
+};
+
+const Alphabet STANDARD_ALPHABET = {
+    {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x80, 0x80, 0x3f,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+    },
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    { 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0 },
+    { 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A },
+    { 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 },
+    { 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 },
+    '/',
+    -1
+};
+
+const Alphabet URL_ALPHABET = {
+    {
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3e, 0x80, 0x80,
+        0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x3f,
+        0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+    },
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+    { 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0 },
+    { 0x25, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x21, 0x23, 0x3B, 0x3B, 0x3A, 0x3B, 0x33 },
+    { 0x20, 0x20, 0x01, 0x02, 0x04, 0x08, 0x04, 0x10, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20 },
+    { 0, 0, 17, 4, -65, -65, -71, -71, -32, 0, 0, 0, 0, 0, 0, 0 },
+    '_',
+    3
+};
+
+namespace {
+
+inline unsigned char lookup(const Alphabet& alphabet, char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u < 0x80) ? alphabet.values[u] : 0x80;
+}
+
+
+/*
+ * Bulk kernels work on fixed size blocks: each reads READ bytes of input,
+ * consumes CONSUMED of them and writes WRITTEN bytes of output. A kernel
+ * returns the number of blocks it completed, stopping early only when a
+ * decode block holds a character outside the alphabet.
+ */
+struct KernelShape {
+    size_t consumed;
+    size_t read;
+    size_t written;
+};
+
+typedef size_t (*EncodeKernel)(const Alphabet& alphabet, const unsigned char* in, size_t blocks, char* out);
+typedef size_t (*DecodeKernel)(const Alphabet& alphabet, const char* in, size_t blocks, unsigned char* out);
+
+
+size_t encodeScalar(const Alphabet& alphabet, const unsigned char* in, size_t length, char* out) {
+    const char* table = alphabet.characters;
+    char* start = out;
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t group = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+        *out++ = table[(group >> 18) & 0x3F];
+        *out++ = table[(group >> 12) & 0x3F];
+        *out++ = table[(group >> 6) & 0x3F];
+        *out++ = table[group & 0x3F];
+    }
+    return static_cast<size_t>(out - start);
+}
+
+
+/*
+ * Decodes until the first invalid character, returning its offset, or length
+ * when all of the input is valid
+ */
+size_t decodeScalar(const Alphabet& alphabet, const char* in, size_t length, unsigned char* out,
+        bool& padded, size_t& written) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; i < length; i += 4) {
+        if (padded) {
+            break;
+        }
+
+        unsigned char a = lookup(alphabet, in[i]);
+        unsigned char b = lookup(alphabet, in[i + 1]);
+        unsigned char c = lookup(alphabet, in[i + 2]);
+        unsigned char d = lookup(alphabet, in[i + 3]);
+        if ((a | b | c | d) & 0x80) {
+            if ((a | b) & 0x80) {
+                i += (a & 0x80) ? 0 : 1;
+                break;
+            }
+
+            //padding may only end the group, as "x=" or "=="
+            bool validPadding = (PAD == in[i + 3]) && (!(c & 0x80) || PAD == in[i + 2]);
+            if (!validPadding) {
+                i += (!(c & 0x80) || PAD == in[i + 2]) ? 3 : 2;
+                break;
+            }
+
+            uint32_t group = (a << 18) | (b << 12);
+            *out++ = static_cast<unsigned char>(group >> 16);
+            if (!(c & 0x80)) {
+                group |= (c << 6);
+                *out++ = static_cast<unsigned char>(group >> 8);
+            }
+            padded = true;
+            continue;
+        }
+
+        uint32_t group = (a << 18) | (b << 12) | (c << 6) | d;
+        *out++ = static_cast<unsigned char>(group >> 16);
+        *out++ = static_cast<unsigned char>(group >> 8);
+        *out++ = static_cast<unsigned char>(group);
+    }
+
+    written = static_cast<size_t>(out - start);
+    return std::min(i, length);
+}
+
+
+#ifdef EZBAKE_BASE64_SIMD
+
+/*
+ * The SSSE3 and AVX2 kernels follow Mula and Lemire, "Faster Base64 Encoding
+ * and Decoding using AVX2 Instructions". Encoding splits each 3 byte group into
+ * four 6 bit indices with multiplies, then maps indices to characters by
+ * adding an offset chosen with a byte shuffle. Decoding classifies characters
+ * by their high and low nibbles, so one shuffle per nibble both validates and
+ * finds the offset back to the 6 bit value.
+ */
+
+const KernelShape SSSE3_ENCODE = { 12, 16, 16 };
+const KernelShape SSSE3_DECODE = { 16, 16, 12 };
+
+__attribute__((target("ssse3")))
+inline __m128i encodeIndices128(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i encodeCharacters128(__m128i indices, __m128i offsets) {
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced = _mm_or_si128(reduced, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(offsets, reduced));
+}
+
+__attribute__((target("ssse3")))
+size_t encodeSsse3(const Alphabet& alphabet, const unsigned char* in, size_t blocks, char* out) {
+    const __m128i offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphabet.encodeOffsets));
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), encodeCharacters128(encodeIndices128(data), offsets));
+        in += SSSE3_ENCODE.consumed;
+        out += SSSE3_ENCODE.written;
+    }
+    return blocks;
+}
+
+/*
+ * Shuffle tables of an alphabet, loaded once per call
+ */
+struct DecodeTables128 {
+    __m128i lowClass;
+    __m128i highClass;
+    __m128i offsets;
+    __m128i special;
+    __m128i specialStep;
+};
+
+__attribute__((target("ssse3")))
+inline DecodeTables128 loadTables128(const Alphabet& alphabet) {
+    DecodeTables128 tables;
+    tables.lowClass = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphabet.lowClass));
+    tables.highClass = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphabet.highClass));
+    tables.offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alphabet.decodeOffsets));
+    tables.special = _mm_set1_epi8(alphabet.special);
+    tables.specialStep = _mm_set1_epi8(alphabet.specialStep);
+    return tables;
+}
+
+/*
+ * Translates characters to 6 bit values, returning false if any is outside the alphabet
+ */
+__attribute__((target("ssse3")))
+inline bool decodeValues128(__m128i& data, const DecodeTables128& tables) {
+    const __m128i nibble = _mm_set1_epi8(0x2F);
+
+    __m128i highNibbles = _mm_and_si128(_mm_srli_epi32(data, 4), nibble);
+    __m128i lowNibbles = _mm_and_si128(data, nibble);
+    __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(tables.lowClass, lowNibbles),
+            _mm_shuffle_epi8(tables.highClass, highNibbles));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) {
+        return false;
+    }
+    //the one character sharing its high nibble with others of a different offset moves to its own slot
+    __m128i step = _mm_and_si128(_mm_cmpeq_epi8(data, tables.special), tables.specialStep);
+    data = _mm_add_epi8(data, _mm_shuffle_epi8(tables.offsets, _mm_add_epi8(highNibbles, step)));
+    return true;
+}
+
+/*
+ * Packs four 6 bit values per 32 bit lane into 3 bytes at the lane's start
+ */
+__attribute__((target("ssse3")))
+inline __m128i packValues128(__m128i values) {
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3")))
+inline void store12(unsigned char* out, __m128i packed) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+    int32_t tail = _mm_cvtsi128_si32(_mm_srli_si128(packed, 8));
+    memcpy(out + 8, &tail, sizeof(tail));
+}
+
+__attribute__((target("ssse3")))
+size_t decodeSsse3(const Alphabet& alphabet, const char* in, size_t blocks, unsigned char* out) {
+    const DecodeTables128 tables = loadTables128(alphabet);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        if (!decodeValues128(data, tables)) {
+            return i;
+        }
+        store12(out, packValues128(data));
+        in += SSSE3_DECODE.consumed;
+        out += SSSE3_DECODE.written;
+    }
+    return blocks;
+}
+
+
+const KernelShape AVX2_ENCODE = { 24, 28, 32 };
+const KernelShape AVX2_DECODE = { 32, 32, 24 };
+
+__attribute__((target("avx2")))
+inline __m256i broadcast256(const signed char* table) {
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+__attribute__((target("avx2")))
+size_t encodeAvx2(const Alphabet& alphabet, const unsigned char* in, size_t blocks, char* out) {
+    const __m256i spread = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+            1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i offsets = broadcast256(alphabet.encodeOffsets);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        //12 bytes in each 128 bit lane
+        __m256i data = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), 1);
+        data = _mm256_shuffle_epi8(data, spread);
+
+        __m256i t0 = _mm256_and_si256(data, _mm256_set1_epi32(0x0fc0fc00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(data, _mm256_set1_epi32(0x003f03f0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        reduced = _mm256_or_si256(reduced, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+        __m256i characters = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, reduced));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), characters);
+        in += AVX2_ENCODE.consumed;
+        out += AVX2_ENCODE.written;
+    }
+    return blocks;
+}
+
+__attribute__((target("avx2")))
+size_t decodeAvx2(const Alphabet& alphabet, const char* in, size_t blocks, unsigned char* out) {
+    const __m256i lowClass = broadcast256(alphabet.lowClass);
+    const __m256i highClass = broadcast256(alphabet.highClass);
+    const __m256i offsets = broadcast256(alphabet.decodeOffsets);
+    const __m256i special = _mm256_set1_epi8(alphabet.special);
+    const __m256i specialStep = _mm256_set1_epi8(alphabet.specialStep);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble = _mm256_set1_epi8(0x2F);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+
+        __m256i highNibbles = _mm256_and_si256(_mm256_srli_epi32(data, 4), nibble);
+        __m256i lowNibbles = _mm256_and_si256(data, nibble);
+        __m256i low = _mm256_shuffle_epi8(lowClass, lowNibbles);
+        __m256i high = _mm256_shuffle_epi8(highClass, highNibbles);
+        if (!_mm256_testz_si256(low, high)) {
+            return i;
+        }
+        __m256i step = _mm256_and_si256(_mm256_cmpeq_epi8(data, special), specialStep);
+        data = _mm256_add_epi8(data, _mm256_shuffle_epi8(offsets, _mm256_add_epi8(highNibbles, step)));
+
+        __m256i merged = _mm256_maddubs_epi16(data, _mm256_set1_epi32(0x01400140));
+        merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, pack);
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(merged));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(merged, 1));
+        in += AVX2_DECODE.consumed;
+        out += AVX2_DECODE.written;
+    }
+    return blocks;
+}
+
+
+/*
+ * The VBMI kernels replace the shuffle arithmetic with full 64 byte table
+ * lookups: multishift extracts the four 6 bit indices of each group directly,
+ * and a two table permute decodes all 128 ASCII characters at once.
+ */
+const KernelShape VBMI_ENCODE = { 48, 48, 64 };
+const KernelShape VBMI_DECODE = { 64, 64, 48 };
+
+const unsigned char VBMI_PACK[64] __attribute__((aligned(64))) = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, 18, 17, 16, 22, 21, 20, 26, 25, 24, 30, 29, 28,
+    34, 33, 32, 38, 37, 36, 42, 41, 40, 46, 45, 44, 50, 49, 48, 54, 53, 52, 58, 57, 56, 62, 61, 60,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+const __mmask64 LOW_48 = 0x0000FFFFFFFFFFFFULL;
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+size_t encodeVbmi(const Alphabet& alphabet, const unsigned char* in, size_t blocks, char* out) {
+    const __m512i spread = _mm512_setr_epi32(
+            0x01020001, 0x04050304, 0x07080607, 0x0a0b090a,
+            0x0d0e0c0d, 0x10110f10, 0x13141213, 0x16171516,
+            0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122,
+            0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e);
+    const __m512i shifts = _mm512_set1_epi64(0x3036242a1016040aLL);
+    const __m512i table = _mm512_load_si512(alphabet.characters);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m512i data = _mm512_maskz_loadu_epi8(LOW_48, in);
+        data = _mm512_permutexvar_epi8(spread, data);
+        __m512i indices = _mm512_multishift_epi64_epi8(shifts, data);
+        _mm512_storeu_si512(out, _mm512_permutexvar_epi8(indices, table));
+        in += VBMI_ENCODE.consumed;
+        out += VBMI_ENCODE.written;
+    }
+    return blocks;
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+size_t decodeVbmi(const Alphabet& alphabet, const char* in, size_t blocks, unsigned char* out) {
+    const __m512i lowTable = _mm512_load_si512(alphabet.values);
+    const __m512i highTable = _mm512_load_si512(alphabet.values + 64);
+    const __m512i pack = _mm512_load_si512(VBMI_PACK);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m512i data = _mm512_loadu_si512(in);
+        __m512i values = _mm512_permutex2var_epi8(lowTable, data, highTable);
+        //the high bit flags characters outside the alphabet and non-ASCII input
+        if (_mm512_movepi8_mask(_mm512_or_si512(values, data))) {
+            return i;
+        }
+
+        __m512i merged = _mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140));
+        merged = _mm512_madd_epi16(merged, _mm512_set1_epi32(0x00011000));
+        _mm512_mask_storeu_epi8(out, LOW_48, _mm512_permutexvar_epi8(pack, merged));
+        in += VBMI_DECODE.consumed;
+        out += VBMI_DECODE.written;
+    }
+    return blocks;
+}
+
+#endif
+
+
+/*
+ * Runs a bulk encode kernel over as much of the input as it can take, then
+ * encodes the rest with the scalar loop.
+ */
+size_t encodeWith(EncodeKernel kernel, const KernelShape& shape, const Alphabet& alphabet,
+        const unsigned char* in, size_t length, char* out) {
+    size_t blocks = (length >= shape.read) ? (length - shape.read) / shape.consumed + 1 : 0;
+
+    //in place, each block must be written before the unread input it would overwrite
+    const char* input = reinterpret_cast<const char*>(in);
+    if (out <= input && input < out + encodedLength(length)) {
+        blocks = std::min(blocks, static_cast<size_t>(input - out) / (shape.written - shape.consumed));
+    }
+
+    blocks = kernel(alphabet, in, blocks, out);
+    size_t consumed = blocks * shape.consumed;
+    return blocks * shape.written + encodeScalar(alphabet, in + consumed, length - consumed, out + blocks * shape.written);
+}
+
+
+/*
+ * Runs a bulk decode kernel over all but the last group, which may hold
+ * padding, then decodes the rest with the scalar loop. The scalar loop also
+ * picks up from any block the kernel rejected, and finds the invalid character.
+ */
+size_t decodeWith(DecodeKernel kernel, const KernelShape& shape, const Alphabet& alphabet,
+        const char* in, size_t length, unsigned char* out, bool& padded, size_t& written) {
+    size_t blocks = 0;
+    if (!padded && length > shape.read) {
+        blocks = kernel(alphabet, in, (length - 4 - shape.read) / shape.consumed + 1, out);
+    }
+    size_t consumed = blocks * shape.consumed;
+    size_t position = consumed + decodeScalar(alphabet, in + consumed, length - consumed,
+            out + blocks * shape.written, padded, written);
+    written += blocks * shape.written;
+    return position;
+}
+
+} // namespace
+
+
+Isa bestIsa() {
+#ifdef EZBAKE_BASE64_SIMD
+    static const Isa best =
+            (__builtin_cpu_supports("avx512vbmi") && __builtin_cpu_supports("avx512bw")) ? AVX512_VBMI :
+            __builtin_cpu_supports("avx2") ? AVX2 :
+            __builtin_cpu_supports("ssse3") ? SSSE3 : SCALAR;
+    return best;
+#else
+    return SCALAR;
+#endif
+}
+
+
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out) {
+    return encodeTriplets(in, length, out, STANDARD_ALPHABET, bestIsa());
+}
+
+
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out, Isa isa) {
+    return encodeTriplets(in, length, out, STANDARD_ALPHABET, isa);
+}
+
+
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out, const Alphabet& alphabet, Isa isa) {
+    switch (isa) {
+#ifdef EZBAKE_BASE64_SIMD
+    case AVX512_VBMI:
+        return encodeWith(encodeVbmi, VBMI_ENCODE, alphabet, in, length, out);
+    case AVX2:
+        return encodeWith(encodeAvx2, AVX2_ENCODE, alphabet, in, length, out);
+    case SSSE3:
+        return encodeWith(encodeSsse3, SSSE3_ENCODE, alphabet, in, length, out);
+#endif
+    default:
+        return encodeScalar(alphabet, in, length, out);
+    }
+}
+
+
+size_t encodeRemainder(const unsigned char* in, size_t length, char* out, const Alphabet& alphabet, bool pad) {
+    if (0 == length) {
+        return 0;
+    }
+    const char* table = alphabet.characters;
+    uint32_t group = (in[0] << 16) | ((length > 1) ? (in[1] << 8) : 0);
+    out[0] = table[(group >> 18) & 0x3F];
+    out[1] = table[(group >> 12) & 0x3F];
+    if (length > 1) {
+        out[2] = table[(group >> 6) & 0x3F];
+    }
+    if (!pad) {
+        return length + 1;
+    }
+    if (length == 1) {
+        out[2] = PAD;
+    }
+    out[3] = PAD;
+    return 4;
+}
+
+
+size_t decodeQuartets(const char* in, size_t length, unsigned char* out, bool& padded) {
+    return decodeQuartets(in, length, out, padded, bestIsa());
+}
+
+
+size_t decodeQuartets(const char* in, size_t length, unsigned char* out, bool& padded, Isa isa) {
+    size_t written = 0;
+    size_t error = validateAndDecode(in, length, out, padded, written, STANDARD_ALPHABET, isa);
+    if (error != length) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException(
+                "Invalid Base64 character at offset " + boost::lexical_cast<std::string>(error)));
+    }
+    return written;
+}
+
+
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written) {
+    return validateAndDecode(in, length, out, padded, written, STANDARD_ALPHABET, bestIsa());
+}
+
+
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written, Isa isa) {
+    return validateAndDecode(in, length, out, padded, written, STANDARD_ALPHABET, isa);
+}
+
+
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written,
+        const Alphabet& alphabet, Isa isa) {
+    switch (isa) {
+#ifdef EZBAKE_BASE64_SIMD
+    case AVX512_VBMI:
+        return decodeWith(decodeVbmi, VBMI_DECODE, alphabet, in, length, out, padded, written);
+    case AVX2:
+        return decodeWith(decodeAvx2, AVX2_DECODE, alphabet, in, length, out, padded, written);
+    case SSSE3:
+        return decodeWith(decodeSsse3, SSSE3_DECODE, alphabet, in, length, out, padded, written);
+#endif
+    default:
+        return decodeScalar(alphabet, in, length, out, padded, written);
+    }
+}
+
+}}}} // ezbake::common::security::base64kernel
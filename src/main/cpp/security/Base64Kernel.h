@@ -0,0 +1,144 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64Kernel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_BASE64KERNEL_H_
+#define EZBAKE_COMMON_SECURITY_BASE64KERNEL_H_
+
+#include <stdint.h>
+#include <cstddef>
+#include <ezbake/common/security/PbeStringEncryptor.h>
+
+namespace ezbake { namespace common { namespace security { namespace base64kernel {
+
+static const char ENCODE_TABLE[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char PAD = '=';
+
+/*
+ * Encode the final 1 or 2 bytes of a message with padding
+ */
+inline size_t encodeRemainder(const unsigned char* in, size_t length, char* out) {
+    if (0 == length) {
+        return 0;
+    }
+    uint32_t group = (in[0] << 16) | ((length > 1) ? (in[1] << 8) : 0);
+    out[0] = ENCODE_TABLE[(group >> 18) & 0x3F];
+    out[1] = ENCODE_TABLE[(group >> 12) & 0x3F];
+    out[2] = (length > 1) ? ENCODE_TABLE[(group >> 6) & 0x3F] : PAD;
+    out[3] = PAD;
+    return 4;
+}
+
+/*
+ * Returns the length of the padded encoding of length bytes
+ */
+inline size_t encodedLength(size_t length) {
+    return 4 * ((length + 2) / 3);
+}
+
+/*
+ * Instruction set extensions the bulk kernels can use
+ */
+enum Isa {
+    SCALAR,
+    SSSE3,
+    AVX2,
+    AVX512_VBMI
+};
+
+/*
+ * Returns the widest extension supported by this CPU, detected once
+ */
+Isa bestIsa();
+
+/*
+ * Encode complete 3 byte groups. Length must be a multiple of 3.
+ *
+ * May run in place with out at or before in, as long as the encoding fits in
+ * front of the unread input (out + 4 * length / 3 <= in + length).
+ */
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out);
+
+/*
+ * Encode complete 3 byte groups with the kernels of the specified extension,
+ * which must be supported by this CPU
+ */
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out, Isa isa);
+
+/*
+ * The standard alphabet of RFC 4648 section 4, and the URL and filename safe
+ * alphabet of section 5 which replaces '+' and '/' with '-' and '_'
+ */
+struct Alphabet;
+extern const Alphabet STANDARD_ALPHABET;
+extern const Alphabet URL_ALPHABET;
+
+/*
+ * Encode complete 3 byte groups in the specified alphabet
+ */
+size_t encodeTriplets(const unsigned char* in, size_t length, char* out, const Alphabet& alphabet, Isa isa);
+
+/*
+ * Encode the final 1 or 2 bytes of a message in the specified alphabet,
+ * padded to 4 characters or not
+ */
+size_t encodeRemainder(const unsigned char* in, size_t length, char* out, const Alphabet& alphabet, bool pad);
+
+/*
+ * Decode complete 4 character groups. Length must be a multiple of 4.
+ * Sets padded when the last group ends in padding. May run in place with out
+ * at or before in.
+ *
+ * @throws StringEncryptorException naming the offset of the first invalid character
+ */
+size_t decodeQuartets(const char* in, size_t length, unsigned char* out, bool& padded);
+
+/*
+ * Decode complete 4 character groups with the kernels of the specified
+ * extension, which must be supported by this CPU
+ */
+size_t decodeQuartets(const char* in, size_t length, unsigned char* out, bool& padded, Isa isa);
+
+/*
+ * Decode complete 4 character groups without throwing. Validation and
+ * decoding are a single pass, so out holds the groups before the first
+ * invalid one when an error is found.
+ *
+ * @param written   set to the number of bytes written to out
+ *
+ * @return offset of the first invalid character, or length if all input is valid
+ */
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written);
+
+/*
+ * Validate and decode with the kernels of the specified extension, which must
+ * be supported by this CPU
+ */
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written, Isa isa);
+
+/*
+ * Validate and decode characters of the specified alphabet
+ */
+size_t validateAndDecode(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written,
+        const Alphabet& alphabet, Isa isa);
+
+}}}} // ezbake::common::security::base64kernel
+
+#endif /* EZBAKE_COMMON_SECURITY_BASE64KERNEL_H_ */
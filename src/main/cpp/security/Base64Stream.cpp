@@ -0,0 +1,186 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64Stream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/Base64Stream.h>
+#include "Base64Kernel.h"
+#include <algorithm>
+#include <cstring>
+#include <openssl/crypto.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    //sink input is processed in slices of this size; a multiple of both Base64 quanta
+    const size_t SLICE_SIZE = 3072;
+}
+
+
+Base64Encoder::Base64Encoder() : _carryLength(0) {}
+
+
+size_t Base64Encoder::update(const char* data, size_t length, char* out) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    size_t written = 0;
+
+    if (_carryLength) {
+        size_t take = std::min(sizeof(_carry) - _carryLength, length);
+        memcpy(_carry + _carryLength, in, take);
+        _carryLength += take;
+        in += take;
+        length -= take;
+
+        if (_carryLength < sizeof(_carry)) {
+            return 0;
+        }
+        written += base64kernel::encodeTriplets(_carry, sizeof(_carry), out);
+        _carryLength = 0;
+    }
+
+    size_t whole = length - (length % 3);
+    written += base64kernel::encodeTriplets(in, whole, out + written);
+
+    _carryLength = length - whole;
+    memcpy(_carry, in + whole, _carryLength);
+    return written;
+}
+
+
+void Base64Encoder::update(const char* data, size_t length, const OutputSink& sink) {
+    char buffer[4 * ((SLICE_SIZE + 2) / 3)];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_SIZE);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+}
+
+
+void Base64Encoder::update(const struct iovec* buffers, size_t count, const OutputSink& sink) {
+    for (size_t i = 0; i < count; ++i) {
+        update(static_cast<const char*>(buffers[i].iov_base), buffers[i].iov_len, sink);
+    }
+}
+
+
+size_t Base64Encoder::finish(char* out) {
+    size_t written = base64kernel::encodeRemainder(_carry, _carryLength, out);
+    _carryLength = 0;
+    return written;
+}
+
+
+void Base64Encoder::finish(const OutputSink& sink) {
+    char buffer[MAX_FINISH_LENGTH];
+    size_t written = finish(buffer);
+    if (written) {
+        sink(buffer, written);
+    }
+}
+
+
+Base64Decoder::Base64Decoder() : _carryLength(0), _offset(0), _padded(false) {}
+
+
+size_t Base64Decoder::update(const char* data, size_t length, char* out) {
+    unsigned char* decoded = reinterpret_cast<unsigned char*>(out);
+    size_t written = 0;
+
+    if (_carryLength) {
+        size_t take = std::min(sizeof(_carry) - _carryLength, length);
+        memcpy(_carry + _carryLength, data, take);
+        _carryLength += take;
+        data += take;
+        length -= take;
+
+        if (_carryLength < sizeof(_carry)) {
+            return 0;
+        }
+        written += decode(_carry, sizeof(_carry), decoded);
+        _carryLength = 0;
+    }
+
+    size_t whole = length - (length % 4);
+    written += decode(data, whole, decoded + written);
+
+    _carryLength = length - whole;
+    memcpy(_carry, data + whole, _carryLength);
+    return written;
+}
+
+
+void Base64Decoder::update(const char* data, size_t length, const OutputSink& sink) {
+    char buffer[3 * ((SLICE_SIZE + 3) / 4)];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_SIZE);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+    OPENSSL_cleanse(buffer, sizeof(buffer));
+}
+
+
+void Base64Decoder::update(const struct iovec* buffers, size_t count, const OutputSink& sink) {
+    for (size_t i = 0; i < count; ++i) {
+        update(static_cast<const char*>(buffers[i].iov_base), buffers[i].iov_len, sink);
+    }
+}
+
+
+void Base64Decoder::finish() {
+    bool truncated = (_carryLength != 0);
+    reset();
+    if (truncated) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Base64 input is truncated"));
+    }
+}
+
+
+void Base64Decoder::reset() {
+    _carryLength = 0;
+    _offset = 0;
+    _padded = false;
+}
+
+
+size_t Base64Decoder::decode(const char* data, size_t length, unsigned char* out) {
+    size_t written = 0;
+    size_t error = base64kernel::validateAndDecode(data, length, out, _padded, written);
+    if (error != length) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException(
+                "Invalid Base64 character at offset " + boost::lexical_cast<std::string>(_offset + error)));
+    }
+    _offset += length;
+    return written;
+}
+
+}}} // ezbake::common::security
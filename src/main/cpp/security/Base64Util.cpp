@@ -20,39 +20,275 @@
  */
 
 #include <ezbake/common/security/Base64Util.h>
-#include <openssl/pem.h>
+#include "Base64Kernel.h"
+#include <cctype>
+#include <cstring>
+#include <openssl/crypto.h>
 
 namespace ezbake { namespace common { namespace security {
 
-::std::string Base64Util::encode(const char * data, int length) {
-    BIO *b64;
-    BUF_MEM *bptr;
+namespace {
+    //batch items are gathered into slices of this size for the kernels; whole groups of both sides
+    const size_t BATCH_SLICE_SIZE = 12288;
+
+    //most items gathered into one decoding slice
+    const size_t MAX_SLICE_ITEMS = 512;
+
+    //an item gathered into a decoding slice, the characters before its last group
+    struct StagedItem {
+        size_t index;
+        size_t begin;
+        size_t length;
+    };
 
-    b64 = BIO_new(BIO_f_base64());              //create BIO chain
-    b64 = BIO_push(b64, BIO_new(BIO_s_mem()));  //push new block to chain located in memory (memory based chain)
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL); //Ignore newlines - write everything in one line
-    BIO_write(b64, data, length);               //write data to element
-    (void)BIO_flush(b64);                       //flush final block to the chain
-    BIO_get_mem_ptr(b64, &bptr);                //get pointer to memory based chain we created
+    /*
+     * Decodes the gathered groups of a slice of batch items with one kernel
+     * call, restarting after any item holding an invalid character, then
+     * copies each item out to the arena followed by its last group. Padding is
+     * only valid in the last group, so that is decoded on its own.
+     */
+    size_t decodeSlice(const boost::string_ref* items, const char* slice, size_t sliceLength,
+            const StagedItem* staged, size_t stagedCount, unsigned char* decoded,
+            unsigned char* out, size_t& position, Base64Util::Span* spans) {
+        bool failed[MAX_SLICE_ITEMS] = {};
+        size_t from = 0;
 
-    ::std::string encode(bptr->data, bptr->length);
-    BIO_free_all(b64);                          //free all memory allocations in chain
+        while (from < stagedCount) {
+            size_t begin = staged[from].begin, written = 0;
+            bool padded = false;
+            size_t error = begin + base64kernel::validateAndDecode(slice + begin, sliceLength - begin,
+                    decoded + (begin / 4) * 3, padded, written);
+            if (error == sliceLength && !padded) {
+                break;
+            }
 
-    return encode;
+            //a padded group fails the item holding it, not the group that follows
+            size_t culprit = padded ? error - 4 : error;
+            size_t bad = from;
+            while (bad + 1 < stagedCount && staged[bad + 1].begin <= culprit) {
+                ++bad;
+            }
+            failed[bad] = true;
+            from = bad + 1;
+        }
+
+        size_t failures = 0;
+        for (size_t s = 0; s < stagedCount; ++s) {
+            const StagedItem& item = staged[s];
+            size_t body = (item.length / 4) * 3, written = 0;
+            bool padded = false;
+
+            if (!failed[s]) {
+                memcpy(out + position, decoded + (item.begin / 4) * 3, body);
+                failed[s] = (base64kernel::validateAndDecode(items[item.index].data() + item.length, 4,
+                        out + position + body, padded, written) != 4);
+            }
+            spans[item.index].offset = position;
+            spans[item.index].length = failed[s] ? Base64Util::npos : body + written;
+            position += failed[s] ? 0 : body + written;
+            failures += failed[s] ? 1 : 0;
+        }
+        return failures;
+    }
+}
+
+const size_t Base64Util::npos;
+
+::std::string Base64Util::encode(const char * data, int length) {
+    if (length <= 0) {
+        return ::std::string();
+    }
+
+    ::std::string encoded(encodedLength(length), '\0');
+    encodeTo(data, length, &encoded[0]);
+    return encoded;
 }
 
 ::std::string Base64Util::decode(const char * data, int length) {
-    BIO *b64;
-    b64 = BIO_new(BIO_f_base64());
-    b64 = BIO_push(b64, BIO_new_mem_buf(const_cast<char*>(data), length));
-    BIO_set_flags(b64, BIO_FLAGS_BASE64_NO_NL);
-    char *rawdata = new char [length]; //use property that encoded strings are always longer than raw strings
-    int buffread = BIO_read(b64, rawdata, length);
-    BIO_free_all(b64);
-
-    ::std::string decode(rawdata, buffread);
-    delete[] rawdata;
-    return decode;
+    if (length <= 0) {
+        return ::std::string();
+    }
+
+    ::std::string decoded(decodedMaxLength(length), '\0');
+    size_t written = decodeTo(data, length, &decoded[0]);
+    if (written == npos) {
+        return ::std::string();
+    }
+    decoded.resize(written);
+    return decoded;
+}
+
+size_t Base64Util::encodeTo(const char * data, size_t length, char * out) {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    size_t whole = length - (length % 3);
+
+    //copy the remainder first, an in place encoding may overwrite it
+    unsigned char remainder[2];
+    memcpy(remainder, in + whole, length - whole);
+
+    size_t written = base64kernel::encodeTriplets(in, whole, out);
+    written += base64kernel::encodeRemainder(remainder, length - whole, out + written);
+    return written;
+}
+
+void Base64Util::appendEncoded(const char * data, size_t length, ::std::string & out) {
+    size_t start = out.size();
+    out.resize(start + encodedLength(length));
+    encodeTo(data, length, &out[start]);
+}
+
+size_t Base64Util::decodeTo(const char * data, size_t length, char * out) {
+    while (length > 0 && ::isspace(static_cast<unsigned char>(data[length - 1]))) {
+        --length;
+    }
+    while (length > 0 && ::isspace(static_cast<unsigned char>(*data))) {
+        ++data;
+        --length;
+    }
+    if (length % 4 == 1) {
+        return npos;
+    }
+
+    size_t whole = length - (length % 4);
+    unsigned char* decoded = reinterpret_cast<unsigned char*>(out);
+
+    //restore padding that was left off, copied first as decoding in place may overwrite it
+    char last[4] = { base64kernel::PAD, base64kernel::PAD, base64kernel::PAD, base64kernel::PAD };
+    memcpy(last, data + whole, length - whole);
+
+    bool padded = false;
+    size_t written = 0, tail = 0;
+    if (base64kernel::validateAndDecode(data, whole, decoded, padded, written) != whole) {
+        return npos;
+    }
+    if (whole < length &&
+        base64kernel::validateAndDecode(last, sizeof(last), decoded + written, padded, tail) != sizeof(last)) {
+        return npos;
+    }
+    return written + tail;
+}
+
+size_t Base64Util::decodeStrict(const char * data, size_t length, char * out, size_t & errorOffset) {
+    size_t whole = length - (length % 4);
+    bool padded = false;
+    size_t written = 0;
+
+    errorOffset = base64kernel::validateAndDecode(data, whole, reinterpret_cast<unsigned char*>(out), padded, written);
+    if (errorOffset != whole) {
+        return npos;
+    }
+    errorOffset = length;
+    return (whole == length) ? written : npos;
+}
+
+bool Base64Util::appendDecoded(const char * data, size_t length, ::std::string & out) {
+    size_t start = out.size();
+    out.resize(start + decodedMaxLength(length));
+    size_t written = decodeTo(data, length, &out[start]);
+    out.resize(start + ((written == npos) ? 0 : written));
+    return written != npos;
+}
+
+void Base64Util::encodeBatch(const boost::string_ref* items, size_t count, ::std::string & arena, Span* spans) {
+    size_t position = arena.size();
+    for (size_t i = 0; i < count; ++i) {
+        spans[i].offset = position;
+        spans[i].length = encodedLength(items[i].size());
+        position += spans[i].length;
+    }
+    arena.resize(position);
+
+    //items are zero filled to whole groups, so each encoding lands exactly where its span starts
+    unsigned char slice[BATCH_SLICE_SIZE];
+    size_t sliceLength = 0, sliceItem = 0;
+    char* out = &arena[0];
+
+    for (size_t i = 0; i <= count; ++i) {
+        size_t length = (i < count) ? items[i].size() : 0;
+        size_t whole = 3 * ((length + 2) / 3);
+
+        if (i == count || sliceLength + whole > sizeof(slice)) {
+            if (sliceLength) {
+                base64kernel::encodeTriplets(slice, sliceLength, out + spans[sliceItem].offset);
+            }
+            sliceLength = 0;
+            sliceItem = i;
+        }
+        if (i == count) {
+            break;
+        }
+
+        if (whole > sizeof(slice)) {
+            encodeTo(items[i].data(), length, out + spans[i].offset);
+            sliceItem = i + 1;
+            continue;
+        }
+        memcpy(slice + sliceLength, items[i].data(), length);
+        memset(slice + sliceLength + length, 0, whole - length);
+        sliceLength += whole;
+    }
+
+    //the zero fill encoded as 'A's where the padding belongs
+    for (size_t i = 0; i < count; ++i) {
+        size_t remainder = items[i].size() % 3;
+        if (remainder) {
+            memset(out + spans[i].offset + spans[i].length - (3 - remainder), base64kernel::PAD, 3 - remainder);
+        }
+    }
+    OPENSSL_cleanse(slice, sizeof(slice));
+}
+
+size_t Base64Util::decodeBatch(const boost::string_ref* items, size_t count, ::std::string & arena, Span* spans) {
+    size_t position = arena.size(), reserved = 0;
+    for (size_t i = 0; i < count; ++i) {
+        reserved += decodedMaxLength(items[i].size());
+    }
+    arena.resize(position + reserved);
+
+    char slice[BATCH_SLICE_SIZE];
+    unsigned char decoded[(BATCH_SLICE_SIZE / 4) * 3];
+    StagedItem staged[MAX_SLICE_ITEMS];
+    size_t stagedCount = 0, sliceLength = 0, failures = 0;
+    unsigned char* out = reinterpret_cast<unsigned char*>(&arena[0]);
+
+    for (size_t i = 0; i <= count; ++i) {
+        size_t length = (i < count) ? items[i].size() : 0;
+        size_t body = (length >= 4) ? length - 4 : 0;
+
+        if (i == count || stagedCount == MAX_SLICE_ITEMS || sliceLength + body > sizeof(slice)) {
+            failures += decodeSlice(items, slice, sliceLength, staged, stagedCount, decoded, out, position, spans);
+            stagedCount = 0;
+            sliceLength = 0;
+        }
+        if (i == count) {
+            break;
+        }
+
+        if (0 == length || length % 4) {
+            spans[i].offset = position;
+            spans[i].length = (0 == length) ? 0 : npos;
+            failures += (0 == length) ? 0 : 1;
+            continue;
+        }
+        if (body > sizeof(slice)) {
+            size_t errorOffset = 0;
+            size_t written = decodeStrict(items[i].data(), length, reinterpret_cast<char*>(out + position), errorOffset);
+            spans[i].offset = position;
+            spans[i].length = written;
+            position += (written == npos) ? 0 : written;
+            failures += (written == npos) ? 1 : 0;
+            continue;
+        }
+
+        StagedItem item = { i, sliceLength, body };
+        staged[stagedCount++] = item;
+        memcpy(slice + sliceLength, items[i].data(), body);
+        sliceLength += body;
+    }
+
+    arena.resize(position);
+    OPENSSL_cleanse(decoded, sizeof(decoded));
+    return failures;
 }
 
 }}} //ezbake::common::security
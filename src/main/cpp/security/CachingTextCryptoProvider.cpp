@@ -0,0 +1,114 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CachingTextCryptoProvider.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/CachingTextCryptoProvider.h>
+#include <cstring>
+#include <vector>
+#include <openssl/crypto.h>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+CachingTextCryptoProvider::CachingTextCryptoProvider(const boost::shared_ptr<TextCryptoProvider>& provider,
+        unsigned int capacity, uint64_t expiration) :
+    _provider(provider),
+    _cache(capacity, expiration)
+{
+    if (!_provider) {
+        BOOST_THROW_EXCEPTION(SecurityException("A provider to decorate is required"));
+    }
+}
+
+
+std::string CachingTextCryptoProvider::decrypt(const std::string& encryptedMessage) const {
+    Plaintext plaintext = lookup(encryptedMessage);
+    if (!plaintext) {
+        plaintext = decryptAndCache(encryptedMessage);
+    }
+    return plaintext->str();
+}
+
+
+size_t CachingTextCryptoProvider::decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const {
+    Plaintext plaintext = lookup(encryptedMessage);
+    if (!plaintext) {
+        plaintext = decryptAndCache(encryptedMessage);
+    }
+
+    size_t bound = maxDecryptedSize(encryptedMessage.size());
+    if ((TextCryptoProvider::UNKNOWN_SIZE != bound && capacity < bound) || capacity < plaintext->size()) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in decrypting string: output buffer is too small"));
+    }
+    if (plaintext->size()) {
+        std::memcpy(out, plaintext->data(), plaintext->size());
+    }
+    return plaintext->size();
+}
+
+
+void CachingTextCryptoProvider::clear() const {
+    _cache.clear();
+}
+
+
+CachingTextCryptoProvider::Plaintext CachingTextCryptoProvider::lookup(boost::string_ref encryptedMessage) const {
+    boost::optional<Plaintext> cached = _cache.get(std::string(encryptedMessage.data(), encryptedMessage.size()));
+    return cached ? *cached : Plaintext();
+}
+
+
+CachingTextCryptoProvider::Plaintext CachingTextCryptoProvider::decryptAndCache(
+        boost::string_ref encryptedMessage) const {
+    //decrypt into a scratch buffer that is wiped, so the only lasting copy is the secure one
+    size_t bound = _provider->maxDecryptedSize(encryptedMessage.size());
+    std::vector<char> scratch;
+    size_t length = 0;
+    Plaintext plaintext;
+    try {
+        if (TextCryptoProvider::UNKNOWN_SIZE == bound) {
+            //the provider can not size a buffer, so the scratch is the string it returns
+            std::string decrypted = _provider->decrypt(std::string(encryptedMessage.data(), encryptedMessage.size()));
+            scratch.assign(decrypted.begin(), decrypted.end());
+            length = scratch.size();
+            if (!decrypted.empty()) {
+                OPENSSL_cleanse(&decrypted[0], decrypted.size());
+            }
+        } else {
+            scratch.resize(bound);
+            length = _provider->decryptTo(encryptedMessage, scratch.data(), scratch.size());
+        }
+        plaintext.reset(new SecureBuffer(boost::string_ref(scratch.data(), length)));
+    } catch (...) {
+        OPENSSL_cleanse(scratch.data(), scratch.size());
+        throw;
+    }
+    OPENSSL_cleanse(scratch.data(), scratch.size());
+
+    /*
+     * Two threads missing on the same message both decrypt it; the first to
+     * insert wins and both return its result.
+     */
+    boost::optional<Plaintext> existing =
+            _cache.putIfAbsent(std::string(encryptedMessage.data(), encryptedMessage.size()), plaintext);
+    return existing ? *existing : plaintext;
+}
+
+}}} // namespace ezbake::common::security
@@ -0,0 +1,439 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Codec.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/Codec.h>
+#include "Base64Kernel.h"
+#include "CodecKernel.h"
+#include <algorithm>
+#include <cstring>
+#include <openssl/crypto.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    //bytes decoded per transcoding or encoder sink slice; a whole number of groups in every encoding
+    const size_t SLICE_BYTES = 3840;
+
+    //characters per decoder sink slice; a whole number of groups in every encoding
+    const size_t SLICE_CHARS = 7680;
+
+    typedef size_t (*EncodeGroups)(const unsigned char* in, size_t length, char* out);
+    typedef size_t (*EncodeTail)(const unsigned char* in, size_t length, char* out);
+    typedef size_t (*DecodeGroups)(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written);
+
+    size_t encodeBase64Tail(const unsigned char* in, size_t length, char* out) {
+        return base64kernel::encodeRemainder(in, length, out, base64kernel::STANDARD_ALPHABET, true);
+    }
+
+    size_t encodeBase64UrlGroups(const unsigned char* in, size_t length, char* out) {
+        return base64kernel::encodeTriplets(in, length, out, base64kernel::URL_ALPHABET, base64kernel::bestIsa());
+    }
+
+    size_t encodeBase64UrlTail(const unsigned char* in, size_t length, char* out) {
+        return base64kernel::encodeRemainder(in, length, out, base64kernel::URL_ALPHABET, false);
+    }
+
+    size_t decodeBase64UrlGroups(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written) {
+        return base64kernel::validateAndDecode(in, length, out, padded, written,
+                base64kernel::URL_ALPHABET, base64kernel::bestIsa());
+    }
+
+    size_t decodeHexGroups(const char* in, size_t length, unsigned char* out, bool&, size_t& written) {
+        return codeckernel::decodeHex(in, length, out, written);
+    }
+
+    void throwInvalid(const char* name, size_t offset) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException(std::string("Invalid ") + name +
+                " character at offset " + boost::lexical_cast<std::string>(offset)));
+    }
+}
+
+
+/*
+ * Each encoding maps groups of bytes to groups of characters. Encodings
+ * that are not padded may end in a partial group.
+ */
+struct Codec::Scheme {
+    const char* name;
+    size_t groupBytes;
+    size_t groupChars;
+    size_t charBits;
+    bool padded;
+    EncodeGroups encodeGroups;
+    EncodeTail encodeTail;
+    DecodeGroups decodeGroups;
+};
+
+const size_t Codec::npos;
+
+
+const Codec& Codec::base64() {
+    static const Scheme scheme = { "Base64", 3, 4, 6, true,
+            base64kernel::encodeTriplets, encodeBase64Tail, base64kernel::validateAndDecode };
+    static const Codec codec(scheme);
+    return codec;
+}
+
+
+const Codec& Codec::base64Url() {
+    static const Scheme scheme = { "Base64URL", 3, 4, 6, false,
+            encodeBase64UrlGroups, encodeBase64UrlTail, decodeBase64UrlGroups };
+    static const Codec codec(scheme);
+    return codec;
+}
+
+
+const Codec& Codec::base32() {
+    static const Scheme scheme = { "Base32", 5, 8, 5, true,
+            codeckernel::encodeBase32Groups, codeckernel::encodeBase32Remainder, codeckernel::decodeBase32Groups };
+    static const Codec codec(scheme);
+    return codec;
+}
+
+
+const Codec& Codec::hex() {
+    static const Scheme scheme = { "Hex", 1, 2, 4, true,
+            codeckernel::encodeHex, codeckernel::encodeHex, decodeHexGroups };
+    static const Codec codec(scheme);
+    return codec;
+}
+
+
+bool Codec::transcode(const Codec& from, const Codec& to, const char* data, size_t length,
+        std::string& out, size_t& errorOffset) {
+    size_t start = out.size();
+    out.resize(start + to.encodedLength(from.decodedMaxLength(length)));
+
+    //slices are whole groups, so only the last one can end in padding or a partial group
+    const size_t sliceChars = (SLICE_BYTES / from._scheme.groupBytes) * from._scheme.groupChars;
+    unsigned char decoded[SLICE_BYTES];
+    bool padded = false;
+    size_t written = start;
+
+    for (size_t offset = 0; offset < length; offset += sliceChars) {
+        size_t slice = std::min(sliceChars, length - offset);
+        size_t decodedLength = from.decode(data + offset, slice, decoded, padded, errorOffset);
+        if (decodedLength == npos) {
+            errorOffset += offset;
+            out.resize(start);
+            OPENSSL_cleanse(decoded, sizeof(decoded));
+            return false;
+        }
+        written += to.encodeTo(reinterpret_cast<const char*>(decoded), decodedLength, &out[written]);
+    }
+
+    OPENSSL_cleanse(decoded, sizeof(decoded));
+    out.resize(written);
+    errorOffset = length;
+    return true;
+}
+
+
+Codec::Codec(const Scheme& scheme) : _scheme(scheme) {}
+
+
+const char* Codec::name() const {
+    return _scheme.name;
+}
+
+
+size_t Codec::encodedLength(size_t length) const {
+    size_t groups = length / _scheme.groupBytes;
+    size_t tail = length % _scheme.groupBytes;
+    if (0 == tail) {
+        return groups * _scheme.groupChars;
+    }
+    return (groups + (_scheme.padded ? 1 : 0)) * _scheme.groupChars +
+            (_scheme.padded ? 0 : (8 * tail + _scheme.charBits - 1) / _scheme.charBits);
+}
+
+
+size_t Codec::decodedMaxLength(size_t length) const {
+    return _scheme.groupBytes * ((length + _scheme.groupChars - 1) / _scheme.groupChars);
+}
+
+
+size_t Codec::encodeTo(const char* data, size_t length, char* out) const {
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    size_t whole = length - (length % _scheme.groupBytes);
+
+    size_t written = _scheme.encodeGroups(in, whole, out);
+    written += _scheme.encodeTail(in + whole, length - whole, out + written);
+    return written;
+}
+
+
+std::string Codec::encode(const std::string& data) const {
+    std::string encoded;
+    appendEncoded(data.data(), data.length(), encoded);
+    return encoded;
+}
+
+
+void Codec::appendEncoded(const char* data, size_t length, std::string& out) const {
+    size_t start = out.size();
+    out.resize(start + encodedLength(length));
+    encodeTo(data, length, &out[start]);
+}
+
+
+size_t Codec::decodeTo(const char* data, size_t length, char* out, size_t& errorOffset) const {
+    bool padded = false;
+    return decode(data, length, reinterpret_cast<unsigned char*>(out), padded, errorOffset);
+}
+
+
+bool Codec::appendDecoded(const char* data, size_t length, std::string& out) const {
+    size_t start = out.size();
+    size_t errorOffset = 0;
+    out.resize(start + decodedMaxLength(length));
+    size_t written = decodeTo(data, length, &out[start], errorOffset);
+    out.resize(start + ((written == npos) ? 0 : written));
+    return written != npos;
+}
+
+
+size_t Codec::decode(const char* data, size_t length, unsigned char* out, bool& padded, size_t& errorOffset) const {
+    size_t tail = length % _scheme.groupChars;
+    size_t whole = length - tail;
+
+    //restore padding that was left off, copied first as decoding in place may overwrite it
+    char last[8];
+    memset(last, base64kernel::PAD, sizeof(last));
+    memcpy(last, data + whole, tail);
+
+    size_t written = 0;
+    errorOffset = _scheme.decodeGroups(data, whole, out, padded, written);
+    if (errorOffset != whole) {
+        return npos;
+    }
+    if (0 == tail) {
+        errorOffset = length;
+        return written;
+    }
+    if (_scheme.padded) {
+        errorOffset = length;
+        return npos;
+    }
+
+    size_t extra = 0;
+    size_t error = _scheme.decodeGroups(last, _scheme.groupChars, out + written, padded, extra);
+
+    //an error in the restored padding means the final group is too short
+    errorOffset = std::min(whole + error, length);
+    return (error == _scheme.groupChars) ? written + extra : npos;
+}
+
+
+Codec::Encoder::Encoder(const Codec& codec) : _codec(codec), _carryLength(0) {}
+
+
+size_t Codec::Encoder::maxUpdateLength(size_t length) const {
+    const Scheme& scheme = _codec._scheme;
+    return scheme.groupChars * ((length + scheme.groupBytes - 1) / scheme.groupBytes);
+}
+
+
+size_t Codec::Encoder::maxFinishLength() const {
+    return _codec._scheme.groupChars;
+}
+
+
+size_t Codec::Encoder::update(const char* data, size_t length, char* out) {
+    const Scheme& scheme = _codec._scheme;
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    size_t written = 0;
+
+    if (_carryLength) {
+        size_t take = std::min(scheme.groupBytes - _carryLength, length);
+        memcpy(_carry + _carryLength, in, take);
+        _carryLength += take;
+        in += take;
+        length -= take;
+
+        if (_carryLength < scheme.groupBytes) {
+            return 0;
+        }
+        written += scheme.encodeGroups(_carry, scheme.groupBytes, out);
+        _carryLength = 0;
+    }
+
+    size_t whole = length - (length % scheme.groupBytes);
+    written += scheme.encodeGroups(in, whole, out + written);
+
+    _carryLength = length - whole;
+    memcpy(_carry, in + whole, _carryLength);
+    return written;
+}
+
+
+void Codec::Encoder::update(const char* data, size_t length, const OutputSink& sink) {
+    //hex doubles its input, the widest expansion of the encodings
+    char buffer[2 * SLICE_BYTES];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_BYTES);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+}
+
+
+void Codec::Encoder::update(const struct iovec* buffers, size_t count, const OutputSink& sink) {
+    for (size_t i = 0; i < count; ++i) {
+        update(static_cast<const char*>(buffers[i].iov_base), buffers[i].iov_len, sink);
+    }
+}
+
+
+size_t Codec::Encoder::finish(char* out) {
+    size_t written = _codec._scheme.encodeTail(_carry, _carryLength, out);
+    _carryLength = 0;
+    return written;
+}
+
+
+void Codec::Encoder::finish(const OutputSink& sink) {
+    char buffer[sizeof(_carry)];
+    size_t written = finish(buffer);
+    if (written) {
+        sink(buffer, written);
+    }
+}
+
+
+Codec::Decoder::Decoder(const Codec& codec) : _codec(codec), _carryLength(0), _offset(0), _padded(false) {}
+
+
+size_t Codec::Decoder::maxUpdateLength(size_t length) const {
+    return _codec.decodedMaxLength(length);
+}
+
+
+size_t Codec::Decoder::maxFinishLength() const {
+    return _codec._scheme.groupBytes;
+}
+
+
+size_t Codec::Decoder::update(const char* data, size_t length, char* out) {
+    const size_t groupChars = _codec._scheme.groupChars;
+    unsigned char* decoded = reinterpret_cast<unsigned char*>(out);
+    size_t written = 0;
+
+    if (_carryLength) {
+        size_t take = std::min(groupChars - _carryLength, length);
+        memcpy(_carry + _carryLength, data, take);
+        _carryLength += take;
+        data += take;
+        length -= take;
+
+        if (_carryLength < groupChars) {
+            return 0;
+        }
+        written += decode(_carry, groupChars, decoded);
+        _carryLength = 0;
+    }
+
+    size_t whole = length - (length % groupChars);
+    written += decode(data, whole, decoded + written);
+
+    _carryLength = length - whole;
+    memcpy(_carry, data + whole, _carryLength);
+    return written;
+}
+
+
+void Codec::Decoder::update(const char* data, size_t length, const OutputSink& sink) {
+    //every encoding decodes to fewer bytes than characters
+    char buffer[SLICE_CHARS];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_CHARS);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+    OPENSSL_cleanse(buffer, sizeof(buffer));
+}
+
+
+void Codec::Decoder::update(const struct iovec* buffers, size_t count, const OutputSink& sink) {
+    for (size_t i = 0; i < count; ++i) {
+        update(static_cast<const char*>(buffers[i].iov_base), buffers[i].iov_len, sink);
+    }
+}
+
+
+size_t Codec::Decoder::finish(char* out) {
+    size_t pending = _carryLength, offset = _offset, errorOffset = 0, written = 0;
+    bool padded = _padded;
+    reset();
+
+    if (pending) {
+        written = _codec.decode(_carry, pending, reinterpret_cast<unsigned char*>(out), padded, errorOffset);
+    }
+    if (written == npos && errorOffset < pending) {
+        throwInvalid(_codec.name(), offset + errorOffset);
+    }
+    if (written == npos) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException(std::string(_codec.name()) + " input is truncated"));
+    }
+    return written;
+}
+
+
+void Codec::Decoder::finish(const OutputSink& sink) {
+    char buffer[sizeof(_carry)];
+    size_t written = finish(buffer);
+    if (written) {
+        sink(buffer, written);
+    }
+    OPENSSL_cleanse(buffer, sizeof(buffer));
+}
+
+
+void Codec::Decoder::reset() {
+    _carryLength = 0;
+    _offset = 0;
+    _padded = false;
+}
+
+
+size_t Codec::Decoder::decode(const char* data, size_t length, unsigned char* out) {
+    size_t written = 0;
+    size_t error = _codec._scheme.decodeGroups(data, length, out, _padded, written);
+    if (error != length) {
+        throwInvalid(_codec.name(), _offset + error);
+    }
+    _offset += length;
+    return written;
+}
+
+}}} // ezbake::common::security
@@ -0,0 +1,401 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CodecKernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "CodecKernel.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EZBAKE_CODEC_SIMD 1
+//GCC 12 flags the deliberately undefined operand inside the VBMI intrinsics
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#endif
+
+namespace ezbake { namespace common { namespace security { namespace codeckernel {
+
+using namespace base64kernel;
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+//value of each ASCII hex digit, 0x80 for other characters
+const unsigned char HEX_VALUES[128] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+const char BASE32_CHARACTERS[65] __attribute__((aligned(64))) =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+//value of each ASCII Base32 character, 0x80 for characters outside the alphabet
+const unsigned char BASE32_VALUES[128] __attribute__((aligned(64))) = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+    0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+//characters in a padded Base32 group that encode 1, 2, 3 or 4 bytes
+const size_t BASE32_DATA_CHARACTERS[] = { 0, 2, 4, 5, 7 };
+
+inline unsigned char lookup(const unsigned char* values, char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u < 0x80) ? values[u] : 0x80;
+}
+
+
+size_t encodeHexScalar(const unsigned char* in, size_t length, char* out) {
+    for (size_t i = 0; i < length; ++i) {
+        out[2 * i] = HEX_DIGITS[in[i] >> 4];
+        out[2 * i + 1] = HEX_DIGITS[in[i] & 0x0F];
+    }
+    return 2 * length;
+}
+
+
+size_t decodeHexScalar(const char* in, size_t length, unsigned char* out, size_t& written) {
+    size_t i = 0;
+    for (; i < length; i += 2) {
+        unsigned char high = lookup(HEX_VALUES, in[i]);
+        unsigned char low = lookup(HEX_VALUES, in[i + 1]);
+        if ((high | low) & 0x80) {
+            i += (high & 0x80) ? 0 : 1;
+            break;
+        }
+        out[i / 2] = static_cast<unsigned char>((high << 4) | low);
+    }
+    written = i / 2;
+    return i;
+}
+
+
+size_t encodeBase32Scalar(const unsigned char* in, size_t length, char* out) {
+    char* start = out;
+    for (size_t i = 0; i < length; i += 5) {
+        uint64_t group = (static_cast<uint64_t>(in[i]) << 32) | (static_cast<uint64_t>(in[i + 1]) << 24) |
+                (in[i + 2] << 16) | (in[i + 3] << 8) | in[i + 4];
+        for (int shift = 35; shift >= 0; shift -= 5) {
+            *out++ = BASE32_CHARACTERS[(group >> shift) & 0x1F];
+        }
+    }
+    return static_cast<size_t>(out - start);
+}
+
+
+size_t decodeBase32Scalar(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written) {
+    unsigned char* start = out;
+    size_t i = 0;
+
+    for (; i < length; i += 8) {
+        if (padded) {
+            break;
+        }
+
+        uint64_t group = 0;
+        size_t characters = 0;
+        for (; characters < 8; ++characters) {
+            unsigned char value = lookup(BASE32_VALUES, in[i + characters]);
+            if (value & 0x80) {
+                break;
+            }
+            group = (group << 5) | value;
+        }
+
+        if (characters < 8) {
+            //padding must fill the rest of the group, after a whole number of bytes
+            size_t bytes = std::find(BASE32_DATA_CHARACTERS, BASE32_DATA_CHARACTERS + 5, characters)
+                    - BASE32_DATA_CHARACTERS;
+            if (bytes == 5 || bytes == 0) {
+                i += characters;
+                break;
+            }
+            size_t end = characters;
+            while (end < 8 && in[i + end] == PAD) {
+                ++end;
+            }
+            if (end < 8) {
+                i += (in[i + characters] == PAD) ? end : characters;
+                break;
+            }
+
+            group <<= 5 * (8 - characters);
+            for (size_t b = 0; b < bytes; ++b) {
+                *out++ = static_cast<unsigned char>(group >> (32 - 8 * b));
+            }
+            padded = true;
+            continue;
+        }
+
+        for (int shift = 32; shift >= 0; shift -= 8) {
+            *out++ = static_cast<unsigned char>(group >> shift);
+        }
+    }
+
+    written = static_cast<size_t>(out - start);
+    return std::min(i, length);
+}
+
+
+#ifdef EZBAKE_CODEC_SIMD
+
+/*
+ * Hex digits are a 16 entry table lookup on each nibble. Decoding checks the
+ * digit and letter ranges with unsigned minimums and merges digit pairs with
+ * a multiply-add.
+ */
+__attribute__((target("ssse3")))
+size_t encodeHexSsse3(const unsigned char* in, size_t blocks, char* out) {
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS));
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i));
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(data, 4), mask));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(data, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return blocks;
+}
+
+__attribute__((target("ssse3")))
+size_t decodeHexSsse3(const char* in, size_t blocks, unsigned char* out) {
+    for (size_t i = 0; i < blocks; ++i) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i));
+        __m128i digit = _mm_sub_epi8(data, _mm_set1_epi8('0'));
+        __m128i letter = _mm_sub_epi8(_mm_or_si128(data, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+        if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+            return i;
+        }
+        __m128i values = _mm_or_si128(_mm_and_si128(isDigit, digit),
+                _mm_andnot_si128(isDigit, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+        __m128i bytes = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 8 * i), _mm_packus_epi16(bytes, bytes));
+    }
+    return blocks;
+}
+
+__attribute__((target("avx2")))
+size_t encodeHexAvx2(const unsigned char* in, size_t blocks, char* out) {
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(HEX_DIGITS)));
+    const __m256i mask = _mm256_set1_epi8(0x0F);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32 * i));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(data, 4), mask));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(data, mask));
+        //unpack works within 128 bit lanes, so put the lane halves back in order
+        __m256i first = _mm256_unpacklo_epi8(high, low);
+        __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return blocks;
+}
+
+__attribute__((target("avx2")))
+size_t decodeHexAvx2(const char* in, size_t blocks, unsigned char* out) {
+    for (size_t i = 0; i < blocks; ++i) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32 * i));
+        __m256i digit = _mm256_sub_epi8(data, _mm256_set1_epi8('0'));
+        __m256i letter = _mm256_sub_epi8(_mm256_or_si256(data, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+        __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+        if (_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)) != -1) {
+            return i;
+        }
+        __m256i values = _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, isDigit);
+        __m256i bytes = _mm256_maddubs_epi16(values, _mm256_set1_epi16(0x0110));
+        bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm256_castsi256_si128(bytes));
+    }
+    return blocks;
+}
+
+
+/*
+ * Base32 uses the same VBMI technique as Base64: each 5 byte group is
+ * gathered big endian into a 64 bit lane, multishift extracts the eight 5 bit
+ * indices, and a permute maps them through the alphabet. Decoding reverses it
+ * with a two table permute and multiply-adds.
+ */
+const unsigned char BASE32_SPREAD[64] __attribute__((aligned(64))) = {
+    4, 3, 2, 1, 0, 0, 0, 0, 9, 8, 7, 6, 5, 5, 5, 5,
+    14, 13, 12, 11, 10, 10, 10, 10, 19, 18, 17, 16, 15, 15, 15, 15,
+    24, 23, 22, 21, 20, 20, 20, 20, 29, 28, 27, 26, 25, 25, 25, 25,
+    34, 33, 32, 31, 30, 30, 30, 30, 39, 38, 37, 36, 35, 35, 35, 35
+};
+
+const unsigned char BASE32_PACK[64] __attribute__((aligned(64))) = {
+    4, 3, 2, 1, 0, 12, 11, 10, 9, 8, 20, 19, 18, 17, 16, 28, 27, 26, 25, 24,
+    36, 35, 34, 33, 32, 44, 43, 42, 41, 40, 52, 51, 50, 49, 48, 60, 59, 58, 57, 56,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+const __mmask64 LOW_40 = 0x000000FFFFFFFFFFULL;
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+size_t encodeBase32Vbmi(const unsigned char* in, size_t blocks, char* out) {
+    const __m512i spread = _mm512_load_si512(BASE32_SPREAD);
+    const __m512i shifts = _mm512_set1_epi64(0x00050a0f14191e23LL);
+    const __m512i table = _mm512_load_si512(BASE32_CHARACTERS);
+    const __m512i mask = _mm512_set1_epi8(0x1F);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m512i data = _mm512_permutexvar_epi8(spread, _mm512_maskz_loadu_epi8(LOW_40, in + 40 * i));
+        __m512i indices = _mm512_and_si512(_mm512_multishift_epi64_epi8(shifts, data), mask);
+        _mm512_storeu_si512(out + 64 * i, _mm512_permutexvar_epi8(indices, table));
+    }
+    return blocks;
+}
+
+__attribute__((target("avx512f,avx512bw,avx512vbmi")))
+size_t decodeBase32Vbmi(const char* in, size_t blocks, unsigned char* out) {
+    const __m512i lowTable = _mm512_load_si512(BASE32_VALUES);
+    const __m512i highTable = _mm512_load_si512(BASE32_VALUES + 64);
+    const __m512i pack = _mm512_load_si512(BASE32_PACK);
+
+    for (size_t i = 0; i < blocks; ++i) {
+        __m512i data = _mm512_loadu_si512(in + 64 * i);
+        __m512i values = _mm512_permutex2var_epi8(lowTable, data, highTable);
+        if (_mm512_movepi8_mask(_mm512_or_si512(values, data))) {
+            return i;
+        }
+
+        //pairs of 5 bits, then 20 bits per half lane, then the 40 bit group
+        __m512i merged = _mm512_maddubs_epi16(values, _mm512_set1_epi16(0x0120));
+        merged = _mm512_madd_epi16(merged, _mm512_set1_epi32(0x00010400));
+        merged = _mm512_or_si512(_mm512_slli_epi64(merged, 20), _mm512_srli_epi64(merged, 32));
+        _mm512_mask_storeu_epi8(out + 40 * i, LOW_40, _mm512_permutexvar_epi8(pack, merged));
+    }
+    return blocks;
+}
+
+#endif
+
+} // namespace
+
+
+size_t encodeHex(const unsigned char* in, size_t length, char* out) {
+    return encodeHex(in, length, out, bestIsa());
+}
+
+
+size_t encodeHex(const unsigned char* in, size_t length, char* out, Isa isa) {
+    size_t blocks = 0, consumed = 0;
+#ifdef EZBAKE_CODEC_SIMD
+    if (isa >= AVX2) {
+        blocks = encodeHexAvx2(in, length / 32, out);
+        consumed = blocks * 32;
+    } else if (isa == SSSE3) {
+        blocks = encodeHexSsse3(in, length / 16, out);
+        consumed = blocks * 16;
+    }
+#endif
+    return 2 * consumed + encodeHexScalar(in + consumed, length - consumed, out + 2 * consumed);
+}
+
+
+size_t decodeHex(const char* in, size_t length, unsigned char* out, size_t& written) {
+    return decodeHex(in, length, out, written, bestIsa());
+}
+
+
+size_t decodeHex(const char* in, size_t length, unsigned char* out, size_t& written, Isa isa) {
+    size_t blocks = 0, consumed = 0;
+#ifdef EZBAKE_CODEC_SIMD
+    if (isa >= AVX2) {
+        blocks = decodeHexAvx2(in, length / 32, out);
+        consumed = blocks * 32;
+    } else if (isa == SSSE3) {
+        blocks = decodeHexSsse3(in, length / 16, out);
+        consumed = blocks * 16;
+    }
+#endif
+    size_t position = consumed + decodeHexScalar(in + consumed, length - consumed, out + consumed / 2, written);
+    written += consumed / 2;
+    return position;
+}
+
+
+size_t encodeBase32Groups(const unsigned char* in, size_t length, char* out) {
+    return encodeBase32Groups(in, length, out, bestIsa());
+}
+
+
+size_t encodeBase32Groups(const unsigned char* in, size_t length, char* out, Isa isa) {
+    size_t blocks = 0;
+#ifdef EZBAKE_CODEC_SIMD
+    if (isa == AVX512_VBMI) {
+        blocks = encodeBase32Vbmi(in, length / 40, out);
+    }
+#endif
+    return 64 * blocks + encodeBase32Scalar(in + 40 * blocks, length - 40 * blocks, out + 64 * blocks);
+}
+
+
+size_t encodeBase32Remainder(const unsigned char* in, size_t length, char* out) {
+    if (0 == length) {
+        return 0;
+    }
+    unsigned char group[5] = { 0, 0, 0, 0, 0 };
+    memcpy(group, in, length);
+    encodeBase32Scalar(group, sizeof(group), out);
+    memset(out + BASE32_DATA_CHARACTERS[length], PAD, 8 - BASE32_DATA_CHARACTERS[length]);
+    return 8;
+}
+
+
+size_t decodeBase32Groups(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written) {
+    return decodeBase32Groups(in, length, out, padded, written, bestIsa());
+}
+
+
+size_t decodeBase32Groups(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written, Isa isa) {
+    size_t blocks = 0;
+#ifdef EZBAKE_CODEC_SIMD
+    //the last group may hold padding, and is left to the scalar loop
+    if (isa == AVX512_VBMI && !padded && length > 64) {
+        blocks = decodeBase32Vbmi(in, (length - 8) / 64, out);
+    }
+#endif
+    size_t position = 64 * blocks + decodeBase32Scalar(in + 64 * blocks, length - 64 * blocks,
+            out + 40 * blocks, padded, written);
+    written += 40 * blocks;
+    return position;
+}
+
+}}}} // ezbake::common::security::codeckernel
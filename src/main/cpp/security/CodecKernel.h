@@ -0,0 +1,75 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CodecKernel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_CODECKERNEL_H_
+#define EZBAKE_COMMON_SECURITY_CODECKERNEL_H_
+
+#include <cstddef>
+#include "Base64Kernel.h"
+
+namespace ezbake { namespace common { namespace security { namespace codeckernel {
+
+using base64kernel::Isa;
+
+/*
+ * Encode bytes as 2 lower case hex digits each. Out must not overlap in.
+ */
+size_t encodeHex(const unsigned char* in, size_t length, char* out);
+size_t encodeHex(const unsigned char* in, size_t length, char* out, Isa isa);
+
+/*
+ * Decode pairs of hex digits of either case. Length must be even. May run in
+ * place with out at or before in.
+ *
+ * @param written   set to the number of bytes written to out
+ *
+ * @return offset of the first invalid character, or length if all input is valid
+ */
+size_t decodeHex(const char* in, size_t length, unsigned char* out, size_t& written);
+size_t decodeHex(const char* in, size_t length, unsigned char* out, size_t& written, Isa isa);
+
+/*
+ * Encode complete 5 byte groups in the Base32 alphabet of RFC 4648 section 6.
+ * Length must be a multiple of 5. Out must not overlap in.
+ */
+size_t encodeBase32Groups(const unsigned char* in, size_t length, char* out);
+size_t encodeBase32Groups(const unsigned char* in, size_t length, char* out, Isa isa);
+
+/*
+ * Encode the final 1 to 4 bytes of a message in Base32, padded to 8 characters
+ */
+size_t encodeBase32Remainder(const unsigned char* in, size_t length, char* out);
+
+/*
+ * Decode complete 8 character Base32 groups. Length must be a multiple of 8.
+ * Sets padded when the last group ends in padding. May run in place with out
+ * at or before in.
+ *
+ * @param written   set to the number of bytes written to out
+ *
+ * @return offset of the first invalid character, or length if all input is valid
+ */
+size_t decodeBase32Groups(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written);
+size_t decodeBase32Groups(const char* in, size_t length, unsigned char* out, bool& padded, size_t& written, Isa isa);
+
+}}}} // ezbake::common::security::codeckernel
+
+#endif /* EZBAKE_COMMON_SECURITY_CODECKERNEL_H_ */
@@ -0,0 +1,177 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CryptoRuntime.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/CryptoRuntime.h>
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    /*
+     * Contexts cached for the life of each thread
+     */
+    struct ThreadContexts {
+        ThreadContexts() : digest(NULL), digestBorrowed(false), cipher(NULL), cipherBorrowed(false) {}
+
+        ~ThreadContexts() {
+            EVP_MD_CTX_destroy(digest);
+            EVP_CIPHER_CTX_free(cipher);
+        }
+
+        EVP_MD_CTX* digest;
+        bool digestBorrowed;
+        EVP_CIPHER_CTX* cipher;
+        bool cipherBorrowed;
+    };
+
+    thread_local ThreadContexts threadContexts;
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    EVP_MD* fetchDigest(const char* name, const EVP_MD* fallback) {
+        EVP_MD* md = EVP_MD_fetch(NULL, name, NULL);
+        return md ? md : const_cast<EVP_MD*>(fallback);
+    }
+
+    EVP_CIPHER* fetchCipher(const char* name, const EVP_CIPHER* fallback) {
+        EVP_CIPHER* cipher = EVP_CIPHER_fetch(NULL, name, NULL);
+        return cipher ? cipher : const_cast<EVP_CIPHER*>(fallback);
+    }
+#else
+    EVP_MD* fetchDigest(const char*, const EVP_MD* md) {
+        return const_cast<EVP_MD*>(md);
+    }
+
+    EVP_CIPHER* fetchCipher(const char*, const EVP_CIPHER* cipher) {
+        return const_cast<EVP_CIPHER*>(cipher);
+    }
+#endif
+
+    /*
+     * Return a context to its freshly allocated state so the next borrower can
+     * initialize it. The _reset calls were added in OpenSSL 1.1.0; before that
+     * _cleanup frees the context state and zeroes it for reuse.
+     */
+    void resetDigestContext(EVP_MD_CTX* ctx) {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+        EVP_MD_CTX_reset(ctx);
+#else
+        EVP_MD_CTX_cleanup(ctx);
+#endif
+    }
+
+    void resetCipherContext(EVP_CIPHER_CTX* ctx) {
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+        EVP_CIPHER_CTX_reset(ctx);
+#else
+        EVP_CIPHER_CTX_cleanup(ctx);
+#endif
+    }
+}
+
+
+const CryptoRuntime& CryptoRuntime::instance() {
+    static CryptoRuntime runtime;
+    return runtime;
+}
+
+
+CryptoRuntime::CryptoRuntime() :
+    _md5(fetchDigest("MD5", EVP_md5())),
+    _sha256(fetchDigest("SHA2-256", EVP_sha256())),
+    _aes256Gcm(fetchCipher("AES-256-GCM", EVP_aes_256_gcm()))
+{}
+
+
+CryptoRuntime::~CryptoRuntime() {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    //freeing a static algorithm is a no-op
+    EVP_MD_free(_md5);
+    EVP_MD_free(_sha256);
+    EVP_CIPHER_free(_aes256Gcm);
+#endif
+}
+
+
+DigestContext::DigestContext() :
+    _ctx(NULL),
+    _cached(!threadContexts.digestBorrowed)
+{
+    if (_cached) {
+        if (!threadContexts.digest) {
+            threadContexts.digest = EVP_MD_CTX_create();
+        }
+        _ctx = threadContexts.digest;
+    } else {
+        _ctx = EVP_MD_CTX_create();
+    }
+
+    if (!_ctx) {
+        BOOST_THROW_EXCEPTION(SecurityException("Unable to allocate digest context"));
+    }
+    if (_cached) {
+        threadContexts.digestBorrowed = true;
+    }
+}
+
+
+DigestContext::~DigestContext() {
+    if (_cached) {
+        resetDigestContext(_ctx);
+        threadContexts.digestBorrowed = false;
+    } else {
+        EVP_MD_CTX_destroy(_ctx);
+    }
+}
+
+
+CipherContext::CipherContext() :
+    _ctx(NULL),
+    _cached(!threadContexts.cipherBorrowed)
+{
+    if (_cached) {
+        if (!threadContexts.cipher) {
+            threadContexts.cipher = EVP_CIPHER_CTX_new();
+        }
+        _ctx = threadContexts.cipher;
+    } else {
+        _ctx = EVP_CIPHER_CTX_new();
+    }
+
+    if (!_ctx) {
+        BOOST_THROW_EXCEPTION(SecurityException("Unable to allocate cipher context"));
+    }
+    if (_cached) {
+        threadContexts.cipherBorrowed = true;
+    }
+}
+
+
+CipherContext::~CipherContext() {
+    if (_cached) {
+        resetCipherContext(_ctx);
+        threadContexts.cipherBorrowed = false;
+    } else {
+        EVP_CIPHER_CTX_free(_ctx);
+    }
+}
+
+}}} // ezbake::common::security
@@ -0,0 +1,374 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * DesKernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "DesKernel.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EZBAKE_DES_MULTI_BUFFER 1
+#include <immintrin.h>
+#endif
+
+namespace ezbake { namespace common { namespace security { namespace deskernel {
+
+namespace {
+
+/*
+ * Combined S-box and P permutation tables, in the bit layout of the OpenSSL
+ * key schedule so DES_key_schedule can be used as is.
+ */
+const uint32_t SP_TRANS[8][64] = {
+    {
+        0x02080800, 0x00080000, 0x02000002, 0x02080802, 0x02000000, 0x00080802,
+        0x00080002, 0x02000002, 0x00080802, 0x02080800, 0x02080000, 0x00000802,
+        0x02000802, 0x02000000, 0x00000000, 0x00080002, 0x00080000, 0x00000002,
+        0x02000800, 0x00080800, 0x02080802, 0x02080000, 0x00000802, 0x02000800,
+        0x00000002, 0x00000800, 0x00080800, 0x02080002, 0x00000800, 0x02000802,
+        0x02080002, 0x00000000, 0x00000000, 0x02080802, 0x02000800, 0x00080002,
+        0x02080800, 0x00080000, 0x00000802, 0x02000800, 0x02080002, 0x00000800,
+        0x00080800, 0x02000002, 0x00080802, 0x00000002, 0x02000002, 0x02080000,
+        0x02080802, 0x00080800, 0x02080000, 0x02000802, 0x02000000, 0x00000802,
+        0x00080002, 0x00000000, 0x00080000, 0x02000000, 0x02000802, 0x02080800,
+        0x00000002, 0x02080002, 0x00000800, 0x00080802,
+    },
+    {
+        0x40108010, 0x00000000, 0x00108000, 0x40100000, 0x40000010, 0x00008010,
+        0x40008000, 0x00108000, 0x00008000, 0x40100010, 0x00000010, 0x40008000,
+        0x00100010, 0x40108000, 0x40100000, 0x00000010, 0x00100000, 0x40008010,
+        0x40100010, 0x00008000, 0x00108010, 0x40000000, 0x00000000, 0x00100010,
+        0x40008010, 0x00108010, 0x40108000, 0x40000010, 0x40000000, 0x00100000,
+        0x00008010, 0x40108010, 0x00100010, 0x40108000, 0x40008000, 0x00108010,
+        0x40108010, 0x00100010, 0x40000010, 0x00000000, 0x40000000, 0x00008010,
+        0x00100000, 0x40100010, 0x00008000, 0x40000000, 0x00108010, 0x40008010,
+        0x40108000, 0x00008000, 0x00000000, 0x40000010, 0x00000010, 0x40108010,
+        0x00108000, 0x40100000, 0x40100010, 0x00100000, 0x00008010, 0x40008000,
+        0x40008010, 0x00000010, 0x40100000, 0x00108000,
+    },
+    {
+        0x04000001, 0x04040100, 0x00000100, 0x04000101, 0x00040001, 0x04000000,
+        0x04000101, 0x00040100, 0x04000100, 0x00040000, 0x04040000, 0x00000001,
+        0x04040101, 0x00000101, 0x00000001, 0x04040001, 0x00000000, 0x00040001,
+        0x04040100, 0x00000100, 0x00000101, 0x04040101, 0x00040000, 0x04000001,
+        0x04040001, 0x04000100, 0x00040101, 0x04040000, 0x00040100, 0x00000000,
+        0x04000000, 0x00040101, 0x04040100, 0x00000100, 0x00000001, 0x00040000,
+        0x00000101, 0x00040001, 0x04040000, 0x04000101, 0x00000000, 0x04040100,
+        0x00040100, 0x04040001, 0x00040001, 0x04000000, 0x04040101, 0x00000001,
+        0x00040101, 0x04000001, 0x04000000, 0x04040101, 0x00040000, 0x04000100,
+        0x04000101, 0x00040100, 0x04000100, 0x00000000, 0x04040001, 0x00000101,
+        0x04000001, 0x00040101, 0x00000100, 0x04040000,
+    },
+    {
+        0x00401008, 0x10001000, 0x00000008, 0x10401008, 0x00000000, 0x10400000,
+        0x10001008, 0x00400008, 0x10401000, 0x10000008, 0x10000000, 0x00001008,
+        0x10000008, 0x00401008, 0x00400000, 0x10000000, 0x10400008, 0x00401000,
+        0x00001000, 0x00000008, 0x00401000, 0x10001008, 0x10400000, 0x00001000,
+        0x00001008, 0x00000000, 0x00400008, 0x10401000, 0x10001000, 0x10400008,
+        0x10401008, 0x00400000, 0x10400008, 0x00001008, 0x00400000, 0x10000008,
+        0x00401000, 0x10001000, 0x00000008, 0x10400000, 0x10001008, 0x00000000,
+        0x00001000, 0x00400008, 0x00000000, 0x10400008, 0x10401000, 0x00001000,
+        0x10000000, 0x10401008, 0x00401008, 0x00400000, 0x10401008, 0x00000008,
+        0x10001000, 0x00401008, 0x00400008, 0x00401000, 0x10400000, 0x10001008,
+        0x00001008, 0x10000000, 0x10000008, 0x10401000,
+    },
+    {
+        0x08000000, 0x00010000, 0x00000400, 0x08010420, 0x08010020, 0x08000400,
+        0x00010420, 0x08010000, 0x00010000, 0x00000020, 0x08000020, 0x00010400,
+        0x08000420, 0x08010020, 0x08010400, 0x00000000, 0x00010400, 0x08000000,
+        0x00010020, 0x00000420, 0x08000400, 0x00010420, 0x00000000, 0x08000020,
+        0x00000020, 0x08000420, 0x08010420, 0x00010020, 0x08010000, 0x00000400,
+        0x00000420, 0x08010400, 0x08010400, 0x08000420, 0x00010020, 0x08010000,
+        0x00010000, 0x00000020, 0x08000020, 0x08000400, 0x08000000, 0x00010400,
+        0x08010420, 0x00000000, 0x00010420, 0x08000000, 0x00000400, 0x00010020,
+        0x08000420, 0x00000400, 0x00000000, 0x08010420, 0x08010020, 0x08010400,
+        0x00000420, 0x00010000, 0x00010400, 0x08010020, 0x08000400, 0x00000420,
+        0x00000020, 0x00010420, 0x08010000, 0x08000020,
+    },
+    {
+        0x80000040, 0x00200040, 0x00000000, 0x80202000, 0x00200040, 0x00002000,
+        0x80002040, 0x00200000, 0x00002040, 0x80202040, 0x00202000, 0x80000000,
+        0x80002000, 0x80000040, 0x80200000, 0x00202040, 0x00200000, 0x80002040,
+        0x80200040, 0x00000000, 0x00002000, 0x00000040, 0x80202000, 0x80200040,
+        0x80202040, 0x80200000, 0x80000000, 0x00002040, 0x00000040, 0x00202000,
+        0x00202040, 0x80002000, 0x00002040, 0x80000000, 0x80002000, 0x00202040,
+        0x80202000, 0x00200040, 0x00000000, 0x80002000, 0x80000000, 0x00002000,
+        0x80200040, 0x00200000, 0x00200040, 0x80202040, 0x00202000, 0x00000040,
+        0x80202040, 0x00202000, 0x00200000, 0x80002040, 0x80000040, 0x80200000,
+        0x00202040, 0x00000000, 0x00002000, 0x80000040, 0x80002040, 0x80202000,
+        0x80200000, 0x00002040, 0x00000040, 0x80200040,
+    },
+    {
+        0x00004000, 0x00000200, 0x01000200, 0x01000004, 0x01004204, 0x00004004,
+        0x00004200, 0x00000000, 0x01000000, 0x01000204, 0x00000204, 0x01004000,
+        0x00000004, 0x01004200, 0x01004000, 0x00000204, 0x01000204, 0x00004000,
+        0x00004004, 0x01004204, 0x00000000, 0x01000200, 0x01000004, 0x00004200,
+        0x01004004, 0x00004204, 0x01004200, 0x00000004, 0x00004204, 0x01004004,
+        0x00000200, 0x01000000, 0x00004204, 0x01004000, 0x01004004, 0x00000204,
+        0x00004000, 0x00000200, 0x01000000, 0x01004004, 0x01000204, 0x00004204,
+        0x00004200, 0x00000000, 0x00000200, 0x01000004, 0x00000004, 0x01000200,
+        0x00000000, 0x01000204, 0x01000200, 0x00004200, 0x00000204, 0x00004000,
+        0x01004204, 0x01000000, 0x01004200, 0x00000004, 0x00004004, 0x01004204,
+        0x01000004, 0x01004200, 0x01004000, 0x00004004,
+    },
+    {
+        0x20800080, 0x20820000, 0x00020080, 0x00000000, 0x20020000, 0x00800080,
+        0x20800000, 0x20820080, 0x00000080, 0x20000000, 0x00820000, 0x00020080,
+        0x00820080, 0x20020080, 0x20000080, 0x20800000, 0x00020000, 0x00820080,
+        0x00800080, 0x20020000, 0x20820080, 0x20000080, 0x00000000, 0x00820000,
+        0x20000000, 0x00800000, 0x20020080, 0x20800080, 0x00800000, 0x00020000,
+        0x20820000, 0x00000080, 0x00800000, 0x00020000, 0x20000080, 0x20820080,
+        0x00020080, 0x20000000, 0x00000000, 0x00820000, 0x20800080, 0x20020080,
+        0x20020000, 0x00800080, 0x20820000, 0x00000080, 0x00800080, 0x20020000,
+        0x20820080, 0x00800000, 0x20800000, 0x20000080, 0x00820000, 0x00020080,
+        0x20020080, 0x20800000, 0x00000080, 0x20820000, 0x00820080, 0x00000000,
+        0x20000000, 0x20800080, 0x00020000, 0x00820080,
+    },
+};
+
+//number of blocks the scalar kernel interleaves
+const size_t SCALAR_LANES = 4;
+
+inline uint32_t rotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+inline uint32_t load32(const unsigned char* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+inline void store32(unsigned char* out, uint32_t value) {
+    out[0] = static_cast<unsigned char>(value);
+    out[1] = static_cast<unsigned char>(value >> 8);
+    out[2] = static_cast<unsigned char>(value >> 16);
+    out[3] = static_cast<unsigned char>(value >> 24);
+}
+
+#define PERM_OP(a, b, t, n, m) ((t) = ((((a) >> (n)) ^ (b)) & (m)), (b) ^= (t), (a) ^= ((t) << (n)))
+
+//initial permutation, followed by the rotation the table layout expects
+inline void initialPermutation(uint32_t& l, uint32_t& r) {
+    uint32_t t;
+    PERM_OP(r, l, t, 4, 0x0f0f0f0fU);
+    PERM_OP(l, r, t, 16, 0x0000ffffU);
+    PERM_OP(r, l, t, 2, 0x33333333U);
+    PERM_OP(l, r, t, 8, 0x00ff00ffU);
+    PERM_OP(r, l, t, 1, 0x55555555U);
+    r = rotateRight(r, 29);
+    l = rotateRight(l, 29);
+}
+
+inline void finalPermutation(uint32_t& l, uint32_t& r) {
+    uint32_t t;
+    l = rotateRight(l, 3);
+    r = rotateRight(r, 3);
+    PERM_OP(l, r, t, 1, 0x55555555U);
+    PERM_OP(r, l, t, 8, 0x00ff00ffU);
+    PERM_OP(l, r, t, 2, 0x33333333U);
+    PERM_OP(r, l, t, 16, 0x0000ffffU);
+    PERM_OP(l, r, t, 4, 0x0f0f0f0fU);
+}
+
+inline uint32_t feistel(uint32_t r, const uint32_t* subkey) {
+    uint32_t u = r ^ subkey[0];
+    uint32_t t = rotateRight(r ^ subkey[1], 4);
+    return SP_TRANS[0][(u >> 2) & 0x3f] ^ SP_TRANS[2][(u >> 10) & 0x3f] ^
+           SP_TRANS[4][(u >> 18) & 0x3f] ^ SP_TRANS[6][(u >> 26) & 0x3f] ^
+           SP_TRANS[1][(t >> 2) & 0x3f] ^ SP_TRANS[3][(t >> 10) & 0x3f] ^
+           SP_TRANS[5][(t >> 18) & 0x3f] ^ SP_TRANS[7][(t >> 26) & 0x3f];
+}
+
+/*
+ * Decrypts N blocks with their rounds interleaved, so the table lookups of
+ * independent blocks overlap instead of waiting on one another.
+ */
+template <size_t N>
+void decryptInterleaved(const unsigned char* in, unsigned char* out, const DES_key_schedule* const* schedules) {
+    uint32_t l[N], r[N];
+    const uint32_t* keys[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        r[i] = load32(in + i * BLOCK_SIZE);
+        l[i] = load32(in + i * BLOCK_SIZE + 4);
+        initialPermutation(r[i], l[i]);
+        keys[i] = reinterpret_cast<const uint32_t*>(schedules[i]->ks);
+    }
+
+    for (int round = 30; round > 0; round -= 4) {
+        for (size_t i = 0; i < N; ++i) {
+            l[i] ^= feistel(r[i], keys[i] + round);
+        }
+        for (size_t i = 0; i < N; ++i) {
+            r[i] ^= feistel(l[i], keys[i] + round - 2);
+        }
+    }
+
+    for (size_t i = 0; i < N; ++i) {
+        finalPermutation(r[i], l[i]);
+        store32(out + i * BLOCK_SIZE, l[i]);
+        store32(out + i * BLOCK_SIZE + 4, r[i]);
+    }
+}
+
+
+#ifdef EZBAKE_DES_MULTI_BUFFER
+
+#define VPERM_OP(a, b, n, m) { \
+    __m256i t = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi32(a, n), b), _mm256_set1_epi32(m)); \
+    b = _mm256_xor_si256(b, t); \
+    a = _mm256_xor_si256(a, _mm256_slli_epi32(t, n)); }
+
+#define VROTATE_RIGHT(v, n) _mm256_or_si256(_mm256_srli_epi32(v, n), _mm256_slli_epi32(v, 32 - (n)))
+
+#define VLOOKUP(table, v, shift) _mm256_i32gather_epi32(reinterpret_cast<const int*>(SP_TRANS[table]), \
+    _mm256_and_si256(_mm256_srli_epi32(v, shift), mask), 4)
+
+/*
+ * Decrypts LANES blocks, one per 32 bit lane. The S-box lookups use gathers,
+ * and subkeys are transposed so lane i holds the subkey of block i.
+ */
+__attribute__((target("avx2")))
+void decryptAvx2(const unsigned char* in, unsigned char* out, const DES_key_schedule* const* schedules) {
+    uint32_t halves[2][LANES];
+    uint32_t subkeys[32][LANES];
+
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        halves[0][lane] = load32(in + lane * BLOCK_SIZE);
+        halves[1][lane] = load32(in + lane * BLOCK_SIZE + 4);
+    }
+
+    //the common case of a single key needs no transposition
+    bool sharedKey = true;
+    for (size_t lane = 1; lane < LANES; ++lane) {
+        sharedKey = sharedKey && (schedules[lane] == schedules[0]);
+    }
+    __m256i keys[32];
+    if (sharedKey) {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(schedules[0]->ks);
+        for (size_t k = 0; k < 32; ++k) {
+            keys[k] = _mm256_set1_epi32(static_cast<int>(words[k]));
+        }
+    } else {
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const uint32_t* words = reinterpret_cast<const uint32_t*>(schedules[lane]->ks);
+            for (size_t k = 0; k < 32; ++k) {
+                subkeys[k][lane] = words[k];
+            }
+        }
+        for (size_t k = 0; k < 32; ++k) {
+            keys[k] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(subkeys[k]));
+        }
+    }
+
+    const __m256i mask = _mm256_set1_epi32(0x3f);
+    __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(halves[0]));
+    __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(halves[1]));
+
+    VPERM_OP(l, r, 4, 0x0f0f0f0f);
+    VPERM_OP(r, l, 16, 0x0000ffff);
+    VPERM_OP(l, r, 2, 0x33333333);
+    VPERM_OP(r, l, 8, 0x00ff00ff);
+    VPERM_OP(l, r, 1, 0x55555555);
+    l = VROTATE_RIGHT(l, 29);
+    r = VROTATE_RIGHT(r, 29);
+
+    for (int round = 30; round >= 0; round -= 2) {
+        __m256i u = _mm256_xor_si256(r, keys[round]);
+        __m256i t = VROTATE_RIGHT(_mm256_xor_si256(r, keys[round + 1]), 4);
+        __m256i f = _mm256_xor_si256(
+            _mm256_xor_si256(_mm256_xor_si256(VLOOKUP(0, u, 2), VLOOKUP(2, u, 10)),
+                             _mm256_xor_si256(VLOOKUP(4, u, 18), VLOOKUP(6, u, 26))),
+            _mm256_xor_si256(_mm256_xor_si256(VLOOKUP(1, t, 2), VLOOKUP(3, t, 10)),
+                             _mm256_xor_si256(VLOOKUP(5, t, 18), VLOOKUP(7, t, 26))));
+        //swap the halves every round; after all sixteen they are back in place
+        __m256i next = _mm256_xor_si256(l, f);
+        l = r;
+        r = next;
+    }
+
+    l = VROTATE_RIGHT(l, 3);
+    r = VROTATE_RIGHT(r, 3);
+    VPERM_OP(r, l, 1, 0x55555555);
+    VPERM_OP(l, r, 8, 0x00ff00ff);
+    VPERM_OP(r, l, 2, 0x33333333);
+    VPERM_OP(l, r, 16, 0x0000ffff);
+    VPERM_OP(r, l, 4, 0x0f0f0f0f);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(halves[0]), l);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(halves[1]), r);
+    for (size_t lane = 0; lane < LANES; ++lane) {
+        store32(out + lane * BLOCK_SIZE, halves[0][lane]);
+        store32(out + lane * BLOCK_SIZE + 4, halves[1][lane]);
+    }
+    std::memset(halves, 0, sizeof(halves));
+    std::memset(subkeys, 0, sizeof(subkeys));
+}
+
+#undef VPERM_OP
+#undef VROTATE_RIGHT
+#undef VLOOKUP
+
+#endif /* EZBAKE_DES_MULTI_BUFFER */
+
+#undef PERM_OP
+
+} // namespace
+
+
+void decryptBlocksScalar(const unsigned char* in, unsigned char* out, size_t count,
+        const DES_key_schedule* const* schedules) {
+    size_t i = 0;
+    for (; i + SCALAR_LANES <= count; i += SCALAR_LANES) {
+        decryptInterleaved<SCALAR_LANES>(in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, schedules + i);
+    }
+    for (; i < count; ++i) {
+        decryptInterleaved<1>(in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, schedules + i);
+    }
+}
+
+
+bool hasMultiBuffer() {
+#ifdef EZBAKE_DES_MULTI_BUFFER
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+void decryptBlocks(const unsigned char* in, unsigned char* out, size_t count,
+        const DES_key_schedule* const* schedules) {
+#ifdef EZBAKE_DES_MULTI_BUFFER
+    if (hasMultiBuffer()) {
+        size_t whole = count - (count % LANES);
+        for (size_t i = 0; i < whole; i += LANES) {
+            decryptAvx2(in + i * BLOCK_SIZE, out + i * BLOCK_SIZE, schedules + i);
+        }
+        decryptBlocksScalar(in + whole * BLOCK_SIZE, out + whole * BLOCK_SIZE, count - whole, schedules + whole);
+        return;
+    }
+#endif
+    decryptBlocksScalar(in, out, count, schedules);
+}
+
+}}}} // ezbake::common::security::deskernel
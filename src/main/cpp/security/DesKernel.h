@@ -0,0 +1,59 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * DesKernel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_DESKERNEL_H_
+#define EZBAKE_COMMON_SECURITY_DESKERNEL_H_
+
+#include <cstddef>
+#include <openssl/des.h>
+
+namespace ezbake { namespace common { namespace security { namespace deskernel {
+
+static const size_t BLOCK_SIZE = 8;
+
+//number of blocks the multi-buffer kernel decrypts together
+static const size_t LANES = 8;
+
+/**
+ * ECB-decrypts count independent 8 byte blocks, block i under *schedules[i].
+ * Blocks may come from any number of streams; CBC chaining is left to the
+ * caller, since a CBC decryption has no dependency between its blocks.
+ *
+ * Uses the AVX2 multi-buffer kernel when the CPU supports it, and an
+ * interleaved scalar kernel otherwise. Output is identical to DES_ecb_encrypt.
+ */
+void decryptBlocks(const unsigned char* in, unsigned char* out, size_t count,
+        const DES_key_schedule* const* schedules);
+
+/**
+ * Interleaved scalar kernel
+ */
+void decryptBlocksScalar(const unsigned char* in, unsigned char* out, size_t count,
+        const DES_key_schedule* const* schedules);
+
+/**
+ * Returns true if the AVX2 multi-buffer kernel can run on this CPU
+ */
+bool hasMultiBuffer();
+
+}}}} // ezbake::common::security::deskernel
+
+#endif /* EZBAKE_COMMON_SECURITY_DESKERNEL_H_ */
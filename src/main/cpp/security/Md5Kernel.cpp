@@ -0,0 +1,273 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Md5Kernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "Md5Kernel.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EZBAKE_MD5_MULTI_BUFFER 1
+#include <immintrin.h>
+#endif
+
+namespace ezbake { namespace common { namespace security { namespace md5kernel {
+
+namespace {
+
+const uint32_t INIT_A = 0x67452301;
+const uint32_t INIT_B = 0xefcdab89;
+const uint32_t INIT_C = 0x98badcfe;
+const uint32_t INIT_D = 0x10325476;
+
+/*
+ * The 64 MD5 steps for a 16 byte message padded to a single block. Only words
+ * w0-w3 carry the message; the padding byte (word 4) and the bit length (word
+ * 14) are constant and already folded into the step constants of STEPK.
+ */
+#define MD5_STEPS \
+    STEP(F, a, b, c, d, w0, 0xd76aa478, 7) \
+    STEP(F, d, a, b, c, w1, 0xe8c7b756, 12) \
+    STEP(F, c, d, a, b, w2, 0x242070db, 17) \
+    STEP(F, b, c, d, a, w3, 0xc1bdceee, 22) \
+    STEPK(F, a, b, c, d, 0xf57c102f, 7) \
+    STEPK(F, d, a, b, c, 0x4787c62a, 12) \
+    STEPK(F, c, d, a, b, 0xa8304613, 17) \
+    STEPK(F, b, c, d, a, 0xfd469501, 22) \
+    STEPK(F, a, b, c, d, 0x698098d8, 7) \
+    STEPK(F, d, a, b, c, 0x8b44f7af, 12) \
+    STEPK(F, c, d, a, b, 0xffff5bb1, 17) \
+    STEPK(F, b, c, d, a, 0x895cd7be, 22) \
+    STEPK(F, a, b, c, d, 0x6b901122, 7) \
+    STEPK(F, d, a, b, c, 0xfd987193, 12) \
+    STEPK(F, c, d, a, b, 0xa679440e, 17) \
+    STEPK(F, b, c, d, a, 0x49b40821, 22) \
+    STEP(G, a, b, c, d, w1, 0xf61e2562, 5) \
+    STEPK(G, d, a, b, c, 0xc040b340, 9) \
+    STEPK(G, c, d, a, b, 0x265e5a51, 14) \
+    STEP(G, b, c, d, a, w0, 0xe9b6c7aa, 20) \
+    STEPK(G, a, b, c, d, 0xd62f105d, 5) \
+    STEPK(G, d, a, b, c, 0x02441453, 9) \
+    STEPK(G, c, d, a, b, 0xd8a1e681, 14) \
+    STEPK(G, b, c, d, a, 0xe7d3fc48, 20) \
+    STEPK(G, a, b, c, d, 0x21e1cde6, 5) \
+    STEPK(G, d, a, b, c, 0xc3370856, 9) \
+    STEP(G, c, d, a, b, w3, 0xf4d50d87, 14) \
+    STEPK(G, b, c, d, a, 0x455a14ed, 20) \
+    STEPK(G, a, b, c, d, 0xa9e3e905, 5) \
+    STEP(G, d, a, b, c, w2, 0xfcefa3f8, 9) \
+    STEPK(G, c, d, a, b, 0x676f02d9, 14) \
+    STEPK(G, b, c, d, a, 0x8d2a4c8a, 20) \
+    STEPK(H, a, b, c, d, 0xfffa3942, 4) \
+    STEPK(H, d, a, b, c, 0x8771f681, 11) \
+    STEPK(H, c, d, a, b, 0x6d9d6122, 16) \
+    STEPK(H, b, c, d, a, 0xfde5388c, 23) \
+    STEP(H, a, b, c, d, w1, 0xa4beea44, 4) \
+    STEPK(H, d, a, b, c, 0x4bded029, 11) \
+    STEPK(H, c, d, a, b, 0xf6bb4b60, 16) \
+    STEPK(H, b, c, d, a, 0xbebfbc70, 23) \
+    STEPK(H, a, b, c, d, 0x289b7ec6, 4) \
+    STEP(H, d, a, b, c, w0, 0xeaa127fa, 11) \
+    STEP(H, c, d, a, b, w3, 0xd4ef3085, 16) \
+    STEPK(H, b, c, d, a, 0x04881d05, 23) \
+    STEPK(H, a, b, c, d, 0xd9d4d039, 4) \
+    STEPK(H, d, a, b, c, 0xe6db99e5, 11) \
+    STEPK(H, c, d, a, b, 0x1fa27cf8, 16) \
+    STEP(H, b, c, d, a, w2, 0xc4ac5665, 23) \
+    STEP(I, a, b, c, d, w0, 0xf4292244, 6) \
+    STEPK(I, d, a, b, c, 0x432aff97, 10) \
+    STEPK(I, c, d, a, b, 0xab942427, 15) \
+    STEPK(I, b, c, d, a, 0xfc93a039, 21) \
+    STEPK(I, a, b, c, d, 0x655b59c3, 6) \
+    STEP(I, d, a, b, c, w3, 0x8f0ccc92, 10) \
+    STEPK(I, c, d, a, b, 0xffeff47d, 15) \
+    STEP(I, b, c, d, a, w1, 0x85845dd1, 21) \
+    STEPK(I, a, b, c, d, 0x6fa87e4f, 6) \
+    STEPK(I, d, a, b, c, 0xfe2ce6e0, 10) \
+    STEPK(I, c, d, a, b, 0xa3014314, 15) \
+    STEPK(I, b, c, d, a, 0x4e0811a1, 21) \
+    STEPK(I, a, b, c, d, 0xf7537f02, 6) \
+    STEPK(I, d, a, b, c, 0xbd3af235, 10) \
+    STEP(I, c, d, a, b, w2, 0x2ad7d2bb, 15) \
+    STEPK(I, b, c, d, a, 0xeb86d391, 21)
+
+
+uint32_t load32(const unsigned char* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+
+void store32(unsigned char* out, uint32_t value) {
+    out[0] = static_cast<unsigned char>(value);
+    out[1] = static_cast<unsigned char>(value >> 8);
+    out[2] = static_cast<unsigned char>(value >> 16);
+    out[3] = static_cast<unsigned char>(value >> 24);
+}
+
+
+#ifdef EZBAKE_MD5_MULTI_BUFFER
+
+/*
+ * Iterates eight digests, one per 32 bit lane. Words are transposed so lane i
+ * of w0-w3 holds the message of digest i.
+ */
+__attribute__((target("avx2")))
+void iterateAvx2(uint32_t (*words)[LANES], long rounds) {
+#define F(x, y, z) _mm256_xor_si256(z, _mm256_and_si256(x, _mm256_xor_si256(y, z)))
+#define G(x, y, z) _mm256_xor_si256(y, _mm256_and_si256(z, _mm256_xor_si256(x, y)))
+#define H(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define I(x, y, z) _mm256_xor_si256(y, _mm256_or_si256(x, _mm256_xor_si256(z, ones)))
+#define ROTATE(v, s) _mm256_or_si256(_mm256_slli_epi32(v, s), _mm256_srli_epi32(v, 32 - (s)))
+#define STEP(f, a, b, c, d, w, t, s) \
+    a = _mm256_add_epi32(b, ROTATE(_mm256_add_epi32(_mm256_add_epi32(a, f(b, c, d)), \
+            _mm256_add_epi32(w, _mm256_set1_epi32(static_cast<int>(t)))), s));
+#define STEPK(f, a, b, c, d, t, s) \
+    a = _mm256_add_epi32(b, ROTATE(_mm256_add_epi32(_mm256_add_epi32(a, f(b, c, d)), \
+            _mm256_set1_epi32(static_cast<int>(t))), s));
+
+    const __m256i ones = _mm256_set1_epi32(-1);
+    const __m256i initA = _mm256_set1_epi32(static_cast<int>(INIT_A));
+    const __m256i initB = _mm256_set1_epi32(static_cast<int>(INIT_B));
+    const __m256i initC = _mm256_set1_epi32(static_cast<int>(INIT_C));
+    const __m256i initD = _mm256_set1_epi32(static_cast<int>(INIT_D));
+
+    __m256i w0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words[0]));
+    __m256i w1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words[1]));
+    __m256i w2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words[2]));
+    __m256i w3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words[3]));
+
+    for (long round = 0; round < rounds; ++round) {
+        __m256i a = initA, b = initB, c = initC, d = initD;
+        MD5_STEPS
+        w0 = _mm256_add_epi32(a, initA);
+        w1 = _mm256_add_epi32(b, initB);
+        w2 = _mm256_add_epi32(c, initC);
+        w3 = _mm256_add_epi32(d, initD);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[0]), w0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[1]), w1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[2]), w2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(words[3]), w3);
+
+#undef F
+#undef G
+#undef H
+#undef I
+#undef ROTATE
+#undef STEP
+#undef STEPK
+}
+
+
+void iterateMultiBuffer(unsigned char (*digests)[DIGEST_LENGTH], size_t count, long rounds) {
+    uint32_t words[4][LANES];
+
+    for (size_t base = 0; base < count; base += LANES) {
+        //idle lanes of the last group iterate a copy of its first digest
+        size_t lanes = std::min(LANES, count - base);
+        for (size_t lane = 0; lane < LANES; ++lane) {
+            const unsigned char* digest = digests[base + (lane < lanes ? lane : 0)];
+            for (size_t word = 0; word < 4; ++word) {
+                words[word][lane] = load32(digest + 4 * word);
+            }
+        }
+
+        iterateAvx2(words, rounds);
+
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            for (size_t word = 0; word < 4; ++word) {
+                store32(digests[base + lane] + 4 * word, words[word][lane]);
+            }
+        }
+    }
+    std::memset(words, 0, sizeof(words));
+}
+
+#endif /* EZBAKE_MD5_MULTI_BUFFER */
+
+} // namespace
+
+
+void iterateScalar(unsigned char* digest, long rounds) {
+#define F(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define G(x, y, z) ((y) ^ ((z) & ((x) ^ (y))))
+#define H(x, y, z) ((x) ^ (y) ^ (z))
+#define I(x, y, z) ((y) ^ ((x) | ~(z)))
+#define ROTATE(v, s) (((v) << (s)) | ((v) >> (32 - (s))))
+#define STEP(f, a, b, c, d, w, t, s) \
+    a += f(b, c, d) + w + static_cast<uint32_t>(t); a = b + ROTATE(a, s);
+#define STEPK(f, a, b, c, d, t, s) \
+    a += f(b, c, d) + static_cast<uint32_t>(t); a = b + ROTATE(a, s);
+
+    uint32_t w0 = load32(digest);
+    uint32_t w1 = load32(digest + 4);
+    uint32_t w2 = load32(digest + 8);
+    uint32_t w3 = load32(digest + 12);
+
+    for (long round = 0; round < rounds; ++round) {
+        uint32_t a = INIT_A, b = INIT_B, c = INIT_C, d = INIT_D;
+        MD5_STEPS
+        w0 = a + INIT_A;
+        w1 = b + INIT_B;
+        w2 = c + INIT_C;
+        w3 = d + INIT_D;
+    }
+
+    store32(digest, w0);
+    store32(digest + 4, w1);
+    store32(digest + 8, w2);
+    store32(digest + 12, w3);
+
+#undef F
+#undef G
+#undef H
+#undef I
+#undef ROTATE
+#undef STEP
+#undef STEPK
+}
+
+
+bool hasMultiBuffer() {
+#ifdef EZBAKE_MD5_MULTI_BUFFER
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+void iterate(unsigned char (*digests)[DIGEST_LENGTH], size_t count, long rounds) {
+#ifdef EZBAKE_MD5_MULTI_BUFFER
+    if (count > 1 && hasMultiBuffer()) {
+        iterateMultiBuffer(digests, count, rounds);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        iterateScalar(digests[i], rounds);
+    }
+}
+
+}}}} // ezbake::common::security::md5kernel
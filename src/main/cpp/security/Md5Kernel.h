@@ -0,0 +1,57 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Md5Kernel.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#ifndef EZBAKE_COMMON_SECURITY_MD5KERNEL_H_
+#define EZBAKE_COMMON_SECURITY_MD5KERNEL_H_
+
+#include <cstddef>
+
+namespace ezbake { namespace common { namespace security { namespace md5kernel {
+
+//size of an MD5 digest, and of every message the kernel hashes
+static const size_t DIGEST_LENGTH = 16;
+
+//number of digests the multi-buffer kernel iterates together
+static const size_t LANES = 8;
+
+/**
+ * Replaces each of the count digests with MD5(digest), rounds times. This is
+ * the iteration step of PBKDF1 with MD5, specialized for 16 byte messages so
+ * each round is a single compression of a pre-padded block.
+ *
+ * Uses the AVX2 multi-buffer kernel when the CPU supports it and more than one
+ * digest is given, and the scalar kernel otherwise. Both give identical output.
+ */
+void iterate(unsigned char (*digests)[DIGEST_LENGTH], size_t count, long rounds);
+
+/**
+ * Scalar kernel, iterates a single digest
+ */
+void iterateScalar(unsigned char* digest, long rounds);
+
+/**
+ * Returns true if the AVX2 multi-buffer kernel can run on this CPU
+ */
+bool hasMultiBuffer();
+
+}}}} // ezbake::common::security::md5kernel
+
+#endif /* EZBAKE_COMMON_SECURITY_MD5KERNEL_H_ */
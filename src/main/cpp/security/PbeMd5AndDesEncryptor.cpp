@@ -21,6 +21,16 @@
 
 #include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
 #include <ezbake/common/security/Base64Util.h>
+#include <ezbake/common/security/CryptoRuntime.h>
+#include "Base64Kernel.h"
+#include "DesKernel.h"
+#include "Md5Kernel.h"
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <ezbake/common/lrucache/LRUCache.h>
+#include <openssl/crypto.h>
 #include <openssl/evp.h>
 #include <openssl/md5.h>
 #include <boost/throw_exception.hpp>
@@ -30,38 +40,206 @@
 namespace ezbake { namespace common { namespace security {
 
 const unsigned int PbeMd5AndDesEncryptor::ALGO_BLOCK_SIZE = MD5_DIGEST_LENGTH / 2;
+const unsigned int PbeMd5AndDesEncryptor::KEY_CACHE_CAPACITY = 64;
 
 
-std::string PbeMd5AndDesEncryptor::encrypt(const std::string& plaintext, const std::string& password,
-        const std::string salt, long iterations) {
-    int padding = ALGO_BLOCK_SIZE - (static_cast<int>(plaintext.length()) % ALGO_BLOCK_SIZE);
-    std::string pad(padding, static_cast<char>(padding));
-    std::string toEncrypt = plaintext + pad;
+namespace {
+    typedef ::ezbake::common::lrucache::LRUCache<std::string,
+            boost::shared_ptr<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey> > KeyCache;
 
-    PbeMd5AndDesKey key = generateKey(password, salt, iterations);
+    //wipe derived keys once the last user releases them
+    void destroyKey(const PbeMd5AndDesEncryptor::PbeMd5AndDesKey* key) {
+        OPENSSL_cleanse(const_cast<PbeMd5AndDesEncryptor::PbeMd5AndDesKey*>(key), sizeof(*key));
+        delete key;
+    }
+}
 
-    int encryptedReturnedLength = static_cast<int>(toEncrypt.length());
-    unsigned char encryptedReturned[encryptedReturnedLength];
-    DES_ncbc_encrypt(reinterpret_cast<const unsigned char*>(toEncrypt.data()), encryptedReturned,
-            encryptedReturnedLength, &key.schedule, &key.ivec, DES_ENCRYPT);
 
-    return Base64Util::encode(encryptedReturned, encryptedReturnedLength);
+std::string PbeMd5AndDesEncryptor::encrypt(const std::string& plaintext, const std::string& password,
+        const std::string salt, long iterations) {
+    return encrypt(plaintext, *getKey(password, salt, iterations));
 }
 
 
 std::string PbeMd5AndDesEncryptor::decrypt(const std::string& encryptedtext, const std::string& password,
         const std::string salt, long iterations) {
-    std::string data = Base64Util::decode(encryptedtext);
-    PbeMd5AndDesKey key = generateKey(password, salt, iterations);
+    return decrypt(encryptedtext, *getKey(password, salt, iterations));
+}
+
+
+std::string PbeMd5AndDesEncryptor::encrypt(const std::string& plaintext, const PbeMd5AndDesKey& key) {
+    std::string encrypted(encryptedLength(plaintext.length()), '\0');
+    encrypt(plaintext, key, &encrypted[0]);
+    return encrypted;
+}
+
+
+std::string PbeMd5AndDesEncryptor::decrypt(const std::string& encryptedtext, const PbeMd5AndDesKey& key) {
+    std::string decrypted(maxDecryptedLength(encryptedtext.length()), '\0');
+    decrypted.resize(decrypt(encryptedtext, key, &decrypted[0]));
+    return decrypted;
+}
+
+
+size_t PbeMd5AndDesEncryptor::encrypt(boost::string_ref plaintext, const PbeMd5AndDesKey& key, char* out) {
+    size_t fullLength = plaintext.size() - (plaintext.size() % ALGO_BLOCK_SIZE);
+    size_t cipherLength = fullLength + ALGO_BLOCK_SIZE;
+    size_t length = encryptedLength(plaintext.size());
+
+    //encrypt into the tail of the output, then Base64 encode it in place
+    unsigned char* ciphertext = reinterpret_cast<unsigned char*>(out) + (length - cipherLength);
+    DES_cblock ivec;
+    memcpy(&ivec, &key.ivec, sizeof(ivec));
+
+    //DES_ncbc_encrypt takes a non-const schedule but never modifies it
+    DES_key_schedule* schedule = const_cast<DES_key_schedule*>(&key.schedule);
+    if (fullLength) {
+        DES_ncbc_encrypt(reinterpret_cast<const unsigned char*>(plaintext.data()), ciphertext,
+                static_cast<long>(fullLength), schedule, &ivec, DES_ENCRYPT);
+    }
+
+    //PKCS#5 padding; a full block of padding when the plaintext is block aligned
+    unsigned char last[8];
+    size_t remainder = plaintext.size() - fullLength;
+    if (remainder) {
+        memcpy(last, plaintext.data() + fullLength, remainder);
+    }
+    memset(last + remainder, static_cast<int>(ALGO_BLOCK_SIZE - remainder), ALGO_BLOCK_SIZE - remainder);
+    DES_ncbc_encrypt(last, ciphertext + fullLength, ALGO_BLOCK_SIZE, schedule, &ivec, DES_ENCRYPT);
+    OPENSSL_cleanse(last, sizeof(last));
+
+    return Base64Util::encodeTo(reinterpret_cast<const char*>(ciphertext), cipherLength, out);
+}
+
+
+size_t PbeMd5AndDesEncryptor::decrypt(boost::string_ref encryptedtext, const PbeMd5AndDesKey& key, char* out) {
+    if (encryptedtext.empty() || encryptedtext.size() % 4) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Encrypted text is truncated"));
+    }
+
+    unsigned char* data = reinterpret_cast<unsigned char*>(out);
+    bool padded = false;
+    size_t length = base64kernel::decodeQuartets(encryptedtext.data(), encryptedtext.size(), data, padded);
+    if (length % ALGO_BLOCK_SIZE) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Encrypted text is truncated"));
+    }
+
+    //CBC decryption in place; each ciphertext block is read before its plaintext is written
+    DES_cblock ivec;
+    memcpy(&ivec, &key.ivec, sizeof(ivec));
+    DES_ncbc_encrypt(data, data, static_cast<long>(length),
+            const_cast<DES_key_schedule*>(&key.schedule), &ivec, DES_DECRYPT);
+
+    unsigned char padding = data[length - 1];
+    bool valid = (padding >= 1 && padding <= ALGO_BLOCK_SIZE);
+    for (size_t i = length - (valid ? padding : 0); i < length; ++i) {
+        valid = valid && (data[i] == padding);
+    }
+    if (!valid) {
+        OPENSSL_cleanse(data, length);
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Invalid padding in encrypted text"));
+    }
+
+    OPENSSL_cleanse(data + length - padding, padding);
+    return length - padding;
+}
+
+
+BatchErrors PbeMd5AndDesEncryptor::encryptBatch(const std::string* plaintexts, std::string* results, size_t count,
+        const PbeMd5AndDesKey& key) {
+    BatchErrors errors;
+    for (size_t i = 0; i < count; ++i) {
+        try {
+            results[i] = encrypt(plaintexts[i], key);
+        } catch (const std::exception& ex) {
+            results[i].clear();
+            errors.push_back(BatchItemError(i, ex.what()));
+        }
+    }
+    return errors;
+}
+
+
+BatchErrors PbeMd5AndDesEncryptor::decryptBatch(const std::string* encryptedtexts, std::string* results, size_t count,
+        const PbeMd5AndDesKey& key) {
+    std::vector<const PbeMd5AndDesKey*> keys(count, &key);
+    return decryptBatch(encryptedtexts, results, count, keys.data());
+}
+
+
+BatchErrors PbeMd5AndDesEncryptor::decryptBatch(const std::string* encryptedtexts, std::string* results, size_t count,
+        const PbeMd5AndDesKey* const* keys) {
+    BatchErrors errors;
+
+    //decode every message into one buffer of blocks, recording where each one starts
+    size_t encodedLength = 0;
+    for (size_t i = 0; i < count; ++i) {
+        encodedLength += encryptedtexts[i].length();
+    }
+    std::vector<unsigned char> ciphertext(encodedLength / 4 * 3);
+    std::vector<size_t> offsets(count + 1, 0);
+    std::vector<const DES_key_schedule*> schedules;
+    schedules.reserve(ciphertext.size() / deskernel::BLOCK_SIZE);
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& text = encryptedtexts[i];
+        offsets[i] = offset;
+        try {
+            if (text.empty() || text.length() % 4) {
+                BOOST_THROW_EXCEPTION(StringEncryptorException("Encrypted text is truncated"));
+            }
+            bool padded = false;
+            size_t length = base64kernel::decodeQuartets(text.data(), text.length(), &ciphertext[offset], padded);
+            if (length % deskernel::BLOCK_SIZE) {
+                BOOST_THROW_EXCEPTION(StringEncryptorException("Encrypted text is truncated"));
+            }
+            offset += length;
+            schedules.insert(schedules.end(), length / deskernel::BLOCK_SIZE, &keys[i]->schedule);
+        } catch (const std::exception& ex) {
+            offset = offsets[i];
+            results[i].clear();
+            errors.push_back(BatchItemError(i, ex.what()));
+        }
+    }
+    offsets[count] = offset;
+
+    std::vector<unsigned char> plaintext(offset);
+    deskernel::decryptBlocks(ciphertext.data(), plaintext.data(), schedules.size(), schedules.data());
+
+    //chain the blocks of each message and strip the padding
+    BatchErrors::iterator failed = errors.begin();
+    for (size_t i = 0; i < count; ++i) {
+        if (failed != errors.end() && failed->index == i) {
+            ++failed;
+            continue;
+        }
+
+        unsigned char* message = &plaintext[offsets[i]];
+        const unsigned char* previous = keys[i]->ivec;
+        size_t length = offsets[i + 1] - offsets[i];
+        for (size_t block = 0; block < length; block += deskernel::BLOCK_SIZE) {
+            for (size_t j = 0; j < deskernel::BLOCK_SIZE; ++j) {
+                message[block + j] ^= previous[j];
+            }
+            previous = &ciphertext[offsets[i] + block];
+        }
 
-    int decryptedReturnedLength = static_cast<int>(data.length());
-    unsigned char decryptedReturned[decryptedReturnedLength];
-    DES_ncbc_encrypt(reinterpret_cast<const unsigned char*>(data.data()), decryptedReturned,
-            decryptedReturnedLength, &key.schedule, &key.ivec, DES_DECRYPT);
+        unsigned char padding = message[length - 1];
+        bool valid = (padding >= 1 && padding <= deskernel::BLOCK_SIZE);
+        for (size_t j = length - (valid ? padding : 0); j < length; ++j) {
+            valid = valid && (message[j] == padding);
+        }
+        if (!valid) {
+            results[i].clear();
+            failed = errors.insert(failed, BatchItemError(i, "Invalid padding in encrypted text")) + 1;
+            continue;
+        }
+        results[i].assign(reinterpret_cast<const char*>(message), length - padding);
+    }
 
-    std::string decrypted(reinterpret_cast<char *>(decryptedReturned), decryptedReturnedLength);
-    int padValue = static_cast<int>(decrypted[decryptedReturnedLength - 1]);
-    return decrypted.substr(0, decryptedReturnedLength - padValue);
+    OPENSSL_cleanse(plaintext.data(), plaintext.size());
+    return errors;
 }
 
 
@@ -70,50 +248,116 @@ PbeMd5AndDesEncryptor::PbeMd5AndDesKey PbeMd5AndDesEncryptor::generateKey(const
     std::string keyHash = generateDataHash(password, salt, iterations);
 
     PbeMd5AndDesKey retVal;
-    DES_cblock key;
+    makeKey(reinterpret_cast<const unsigned char*>(keyHash.data()), retVal);
+    OPENSSL_cleanse(&keyHash[0], keyHash.length());
 
-    keyHash.copy(reinterpret_cast<char *>(&key), ALGO_BLOCK_SIZE, 0);
-    keyHash.copy(reinterpret_cast<char *>(&retVal.ivec), ALGO_BLOCK_SIZE, ALGO_BLOCK_SIZE);
+    return retVal;
+}
 
-    DES_set_odd_parity(&key);
-    DES_set_key_checked(&key, &retVal.schedule);
 
-    return retVal;
+void PbeMd5AndDesEncryptor::generateKeys(const std::string* passwords, const std::string* salts, size_t count,
+        long iterations, PbeMd5AndDesKey* keys) {
+    std::vector<unsigned char> hashes(count * MD5_DIGEST_LENGTH);
+    unsigned char (*digests)[MD5_DIGEST_LENGTH] = reinterpret_cast<unsigned char (*)[MD5_DIGEST_LENGTH]>(hashes.data());
+
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            hashSeed(passwords[i], salts[i], digests[i]);
+        }
+    } catch (...) {
+        OPENSSL_cleanse(hashes.data(), hashes.size());
+        throw;
+    }
+
+    md5kernel::iterate(digests, count, iterations - 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        makeKey(digests[i], keys[i]);
+    }
+    OPENSSL_cleanse(hashes.data(), hashes.size());
+}
+
+
+boost::shared_ptr<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey> PbeMd5AndDesEncryptor::getKey(
+        const std::string& password, const std::string& salt, long iterations) {
+    static KeyCache cache(KEY_CACHE_CAPACITY);
+
+    std::string digest = generateKeyDigest(password, salt, iterations);
+    boost::optional<boost::shared_ptr<const PbeMd5AndDesKey> > cached = cache.get(digest);
+    if (cached) {
+        return *cached;
+    }
+
+    /*
+     * Derive outside of the cache lock. Two threads racing on the same new key
+     * derive it twice; the first to insert wins and both return its result.
+     */
+    boost::shared_ptr<const PbeMd5AndDesKey> key(new PbeMd5AndDesKey(generateKey(password, salt, iterations)),
+                                                 destroyKey);
+    boost::optional<boost::shared_ptr<const PbeMd5AndDesKey> > existing = cache.putIfAbsent(digest, key);
+    return existing ? *existing : key;
+}
+
+
+std::string PbeMd5AndDesEncryptor::generateKeyDigest(const std::string& password, const std::string& salt,
+        long iterations) {
+    DigestContext ctx;
+    unsigned char result[EVP_MAX_MD_SIZE];
+    unsigned int resultLength = 0;
+
+    //length prefix the password so (password, salt) splits can't collide
+    uint64_t passwordLength = password.length();
+    int64_t rounds = iterations;
+
+    if (!EVP_DigestInit_ex(ctx.get(), CryptoRuntime::instance().sha256(), NULL) ||
+        !EVP_DigestUpdate(ctx.get(), &passwordLength, sizeof(passwordLength)) ||
+        !EVP_DigestUpdate(ctx.get(), password.data(), password.length()) ||
+        !EVP_DigestUpdate(ctx.get(), salt.data(), std::min<size_t>(salt.length(), ALGO_BLOCK_SIZE)) ||
+        !EVP_DigestUpdate(ctx.get(), &rounds, sizeof(rounds)) ||
+        !EVP_DigestFinal_ex(ctx.get(), result, &resultLength)) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Error in generating key digest"));
+    }
+
+    return std::string(reinterpret_cast<char *>(result), resultLength);
 }
 
 
 std::string PbeMd5AndDesEncryptor::generateDataHash(const std::string& data, const std::string salt, long iterations) {
-    EVP_MD_CTX *ctx = EVP_MD_CTX_create();
-    const EVP_MD *algorithm = EVP_md5();
     unsigned char result[MD5_DIGEST_LENGTH];
 
+    hashSeed(data, salt, result);
+    md5kernel::iterateScalar(result, iterations - 1);
+
+    std::string hash(reinterpret_cast<char *>(result), MD5_DIGEST_LENGTH);
+    OPENSSL_cleanse(result, sizeof(result));
+    return hash;
+}
+
+
+void PbeMd5AndDesEncryptor::hashSeed(const std::string& data, const std::string& salt, unsigned char* result) {
     if (salt.length() < ALGO_BLOCK_SIZE) {
         BOOST_THROW_EXCEPTION(StringEncryptorException("Provided salt is of insufficient length"));
     }
 
-    /*
-     * Add digest to digest stack if not already there.
-     * Digest stack gets cleanup upon program termination.
-     */
-    EVP_add_digest(algorithm);
-
-    if (!EVP_DigestInit_ex(ctx, algorithm, NULL) ||
-        !EVP_DigestUpdate(ctx, data.data(), data.length()) ||
-        !EVP_DigestUpdate(ctx, salt.data(), ALGO_BLOCK_SIZE) ||
-        !EVP_DigestFinal_ex(ctx, result, NULL)) {
+    DigestContext ctx;
+    if (!EVP_DigestInit_ex(ctx.get(), CryptoRuntime::instance().md5(), NULL) ||
+        !EVP_DigestUpdate(ctx.get(), data.data(), data.length()) ||
+        !EVP_DigestUpdate(ctx.get(), salt.data(), ALGO_BLOCK_SIZE) ||
+        !EVP_DigestFinal_ex(ctx.get(), result, NULL)) {
         BOOST_THROW_EXCEPTION(StringEncryptorException("Error in generating digest"));
     }
+}
 
-    while (--iterations != 0) {
-        if (!EVP_DigestInit_ex(ctx, algorithm, NULL) ||
-            !EVP_DigestUpdate(ctx, result, MD5_DIGEST_LENGTH) ||
-            !EVP_DigestFinal_ex(ctx, result, NULL)) {
-            BOOST_THROW_EXCEPTION(StringEncryptorException("Error in generating digest"));
-        }
-    }
 
-    EVP_MD_CTX_destroy(ctx);
-    return std::string(reinterpret_cast<char *>(result), MD5_DIGEST_LENGTH);
+void PbeMd5AndDesEncryptor::makeKey(const unsigned char* hash, PbeMd5AndDesKey& key) {
+    DES_cblock desKey;
+
+    std::memcpy(&desKey, hash, ALGO_BLOCK_SIZE);
+    std::memcpy(&key.ivec, hash + ALGO_BLOCK_SIZE, ALGO_BLOCK_SIZE);
+
+    DES_set_odd_parity(&desKey);
+    DES_set_key_checked(&desKey, &key.schedule);
+    OPENSSL_cleanse(&desKey, sizeof(desKey));
 }
 
 
@@ -0,0 +1,256 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * PbeMd5AndDesStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/PbeMd5AndDesStream.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <openssl/crypto.h>
+#include <boost/throw_exception.hpp>
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    const size_t DES_BLOCK_SIZE = 8;
+
+    //input is processed in slices of this size; a multiple of both the DES block and Base64 quanta
+    const size_t SLICE_SIZE = 1536;
+}
+
+
+PbeMd5AndDesStreamEncryptor::PbeMd5AndDesStreamEncryptor(const PbeMd5AndDesEncryptor::PbeMd5AndDesKey& key)
+    : _key(key),
+      _pendingLength(0),
+      _finalized(false) {}
+
+
+PbeMd5AndDesStreamEncryptor::~PbeMd5AndDesStreamEncryptor() {
+    OPENSSL_cleanse(&_key, sizeof(_key));
+    OPENSSL_cleanse(_pending, sizeof(_pending));
+}
+
+
+size_t PbeMd5AndDesStreamEncryptor::update(const char* data, size_t length, char* out) {
+    if (_finalized) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Encryptor has already been finalized"));
+    }
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(data);
+    size_t written = 0;
+
+    if (_pendingLength) {
+        size_t take = std::min(DES_BLOCK_SIZE - _pendingLength, length);
+        memcpy(_pending + _pendingLength, in, take);
+        _pendingLength += take;
+        in += take;
+        length -= take;
+
+        if (_pendingLength < DES_BLOCK_SIZE) {
+            return 0;
+        }
+        written += encryptBlocks(_pending, DES_BLOCK_SIZE, out);
+        _pendingLength = 0;
+    }
+
+    while (length >= DES_BLOCK_SIZE) {
+        size_t slice = std::min(length - (length % DES_BLOCK_SIZE), SLICE_SIZE);
+        written += encryptBlocks(in, slice, out + written);
+        in += slice;
+        length -= slice;
+    }
+
+    memcpy(_pending, in, length);
+    _pendingLength = length;
+    return written;
+}
+
+
+void PbeMd5AndDesStreamEncryptor::update(const char* data, size_t length, const OutputSink& sink) {
+    char buffer[4 * ((SLICE_SIZE + 9) / 3)];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_SIZE);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+}
+
+
+size_t PbeMd5AndDesStreamEncryptor::final(char* out) {
+    if (_finalized) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Encryptor has already been finalized"));
+    }
+
+    //PKCS#5 padding; a full block of padding when the plaintext is block aligned
+    unsigned char padding = static_cast<unsigned char>(DES_BLOCK_SIZE - _pendingLength);
+    memset(_pending + _pendingLength, padding, padding);
+
+    size_t written = encryptBlocks(_pending, DES_BLOCK_SIZE, out);
+    written += _encoder.finish(out + written);
+
+    _pendingLength = 0;
+    _finalized = true;
+    return written;
+}
+
+
+void PbeMd5AndDesStreamEncryptor::final(const OutputSink& sink) {
+    char buffer[MAX_FINAL_LENGTH];
+    size_t written = final(buffer);
+    sink(buffer, written);
+}
+
+
+size_t PbeMd5AndDesStreamEncryptor::encryptBlocks(const unsigned char* data, size_t length, char* out) {
+    unsigned char ciphertext[SLICE_SIZE];
+    DES_ncbc_encrypt(data, ciphertext, static_cast<long>(length), &_key.schedule, &_key.ivec, DES_ENCRYPT);
+    return _encoder.update(reinterpret_cast<const char*>(ciphertext), length, out);
+}
+
+
+PbeMd5AndDesStreamDecryptor::PbeMd5AndDesStreamDecryptor(const PbeMd5AndDesEncryptor::PbeMd5AndDesKey& key)
+    : _key(key),
+      _pendingLength(0),
+      _finalized(false) {}
+
+
+PbeMd5AndDesStreamDecryptor::~PbeMd5AndDesStreamDecryptor() {
+    OPENSSL_cleanse(&_key, sizeof(_key));
+}
+
+
+size_t PbeMd5AndDesStreamDecryptor::update(const char* data, size_t length, char* out) {
+    if (_finalized) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Decryptor has already been finalized"));
+    }
+
+    unsigned char decoded[(SLICE_SIZE / 4) * 3 + 3];
+    size_t written = 0;
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_SIZE);
+        size_t decodedLength = _decoder.update(data, slice, reinterpret_cast<char*>(decoded));
+        data += slice;
+        length -= slice;
+
+        written += decryptBlocks(decoded, decodedLength, out + written);
+    }
+
+    return written;
+}
+
+
+void PbeMd5AndDesStreamDecryptor::update(const char* data, size_t length, const OutputSink& sink) {
+    char buffer[3 * ((SLICE_SIZE + 3) / 4) + 8];
+
+    while (length) {
+        size_t slice = std::min(length, SLICE_SIZE);
+        size_t written = update(data, slice, buffer);
+        if (written) {
+            sink(buffer, written);
+        }
+        data += slice;
+        length -= slice;
+    }
+    OPENSSL_cleanse(buffer, sizeof(buffer));
+}
+
+
+size_t PbeMd5AndDesStreamDecryptor::final(char* out) {
+    if (_finalized) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Decryptor has already been finalized"));
+    }
+    _finalized = true;
+
+    if (_decoder.pending() || _pendingLength != DES_BLOCK_SIZE) {
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Encrypted text is truncated"));
+    }
+
+    unsigned char block[DES_BLOCK_SIZE];
+    DES_ncbc_encrypt(_pending, block, DES_BLOCK_SIZE, &_key.schedule, &_key.ivec, DES_DECRYPT);
+    _pendingLength = 0;
+
+    unsigned char padding = block[DES_BLOCK_SIZE - 1];
+    bool valid = (padding >= 1 && padding <= DES_BLOCK_SIZE);
+    for (size_t i = DES_BLOCK_SIZE - (valid ? padding : 0); i < DES_BLOCK_SIZE; ++i) {
+        valid = valid && (block[i] == padding);
+    }
+    if (!valid) {
+        OPENSSL_cleanse(block, sizeof(block));
+        BOOST_THROW_EXCEPTION(StringEncryptorException("Invalid padding in encrypted text"));
+    }
+
+    size_t written = DES_BLOCK_SIZE - padding;
+    memcpy(out, block, written);
+    OPENSSL_cleanse(block, sizeof(block));
+    return written;
+}
+
+
+void PbeMd5AndDesStreamDecryptor::final(const OutputSink& sink) {
+    char buffer[MAX_FINAL_LENGTH];
+    size_t written = final(buffer);
+    sink(buffer, written);
+    OPENSSL_cleanse(buffer, sizeof(buffer));
+}
+
+
+size_t PbeMd5AndDesStreamDecryptor::decryptBlocks(const unsigned char* data, size_t length, char* out) {
+    unsigned char* plaintext = reinterpret_cast<unsigned char*>(out);
+    size_t written = 0;
+
+    if (_pendingLength) {
+        size_t take = std::min(DES_BLOCK_SIZE - _pendingLength, length);
+        memcpy(_pending + _pendingLength, data, take);
+        _pendingLength += take;
+        data += take;
+        length -= take;
+
+        //hold back a complete block until we know it isn't the last one
+        if (_pendingLength < DES_BLOCK_SIZE || 0 == length) {
+            return 0;
+        }
+        DES_ncbc_encrypt(_pending, plaintext, DES_BLOCK_SIZE, &_key.schedule, &_key.ivec, DES_DECRYPT);
+        written += DES_BLOCK_SIZE;
+        _pendingLength = 0;
+    }
+
+    if (0 == length) {
+        return written;
+    }
+
+    size_t blocks = (length - 1) / DES_BLOCK_SIZE;
+    if (blocks) {
+        DES_ncbc_encrypt(data, plaintext + written, static_cast<long>(blocks * DES_BLOCK_SIZE),
+                &_key.schedule, &_key.ivec, DES_DECRYPT);
+        written += blocks * DES_BLOCK_SIZE;
+    }
+
+    _pendingLength = length - (blocks * DES_BLOCK_SIZE);
+    memcpy(_pending, data + (blocks * DES_BLOCK_SIZE), _pendingLength);
+    return written;
+}
+
+}}} // ezbake::common::security
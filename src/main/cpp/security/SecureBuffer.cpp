@@ -0,0 +1,120 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * SecureBuffer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/security/SecureBuffer.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <openssl/crypto.h>
+
+/*
+ * The OpenSSL secure heap was added in 1.1.0. Older versions always take the
+ * page locked allocation below.
+ */
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+#define EZBAKE_SECUREBUFFER_SECURE_HEAP 1
+#endif
+
+namespace ezbake { namespace common { namespace security {
+
+namespace {
+    bool secureHeapInitialized() {
+#ifdef EZBAKE_SECUREBUFFER_SECURE_HEAP
+        return (CRYPTO_secure_malloc_initialized() != 0);
+#else
+        return false;
+#endif
+    }
+}
+
+
+SecureBuffer::SecureBuffer(boost::string_ref data) :
+    _data(NULL),
+    _size(data.size()),
+    _allocated(0),
+    _secureHeap(secureHeapInitialized()),
+    _locked(false)
+{
+    //allocate at least one byte so data() is never null
+    size_t length = std::max<size_t>(_size, 1);
+
+#ifdef EZBAKE_SECUREBUFFER_SECURE_HEAP
+    if (_secureHeap) {
+        _data = static_cast<char*>(CRYPTO_secure_malloc(length, __FILE__, __LINE__));
+        _allocated = length;
+        _locked = (_data != NULL);
+    }
+#endif
+
+    if (!_data) {
+        /*
+         * munlock() releases whole pages regardless of how often they were
+         * locked, so every buffer gets pages of its own.
+         */
+        _secureHeap = false;
+        size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        _allocated = (length + page - 1) / page * page;
+
+        void* memory = NULL;
+        if (::posix_memalign(&memory, page, _allocated) != 0) {
+            throw std::bad_alloc();
+        }
+        _data = static_cast<char*>(memory);
+        _locked = (::mlock(_data, _allocated) == 0);
+#ifdef MADV_DONTDUMP
+        ::madvise(_data, _allocated, MADV_DONTDUMP);
+#endif
+    }
+
+    if (_size) {
+        std::memcpy(_data, data.data(), _size);
+    }
+}
+
+
+SecureBuffer::~SecureBuffer() {
+#ifdef EZBAKE_SECUREBUFFER_SECURE_HEAP
+    if (_secureHeap) {
+#if OPENSSL_VERSION_NUMBER >= 0x1010007fL
+        CRYPTO_secure_clear_free(_data, _allocated, __FILE__, __LINE__);
+#else
+        //CRYPTO_secure_clear_free was added in 1.1.0g
+        OPENSSL_cleanse(_data, _allocated);
+        CRYPTO_secure_free(_data, __FILE__, __LINE__);
+#endif
+        return;
+    }
+#endif
+
+    OPENSSL_cleanse(_data, _allocated);
+#ifdef MADV_DODUMP
+    ::madvise(_data, _allocated, MADV_DODUMP);
+#endif
+    if (_locked) {
+        ::munlock(_data, _allocated);
+    }
+    std::free(_data);
+}
+
+}}} // ezbake::common::security
@@ -20,18 +20,42 @@
  */
 
 #include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
-#include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
 #include <boost/throw_exception.hpp>
 #include <boost/make_shared.hpp>
+#include <algorithm>
+#include <mutex>
 
 namespace ezbake { namespace common { namespace security {
 
 const std::string SharedSecretTextCryptoProvider::SALT = "bouncycastle";
 
 
+SharedSecretTextCryptoProvider::SharedSecretTextCryptoProvider(const std::string& secret) :
+    _pool(NULL)
+{
+    try {
+        _key = PbeMd5AndDesEncryptor::getKey(secret, SALT, ITERATIONS);
+    } catch (const std::exception &ex) {
+        BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in deriving key: ") + ex.what()));
+    }
+}
+
+
+SharedSecretTextCryptoProvider::SharedSecretTextCryptoProvider(const std::string& secret,
+        ::ezbake::common::utils::ThreadPool& pool) :
+    _pool(&pool)
+{
+    try {
+        _key = PbeMd5AndDesEncryptor::getKey(secret, SALT, ITERATIONS);
+    } catch (const std::exception &ex) {
+        BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in deriving key: ") + ex.what()));
+    }
+}
+
+
 std::string SharedSecretTextCryptoProvider::encrypt(const std::string& message) const {
     try {
-        return PbeMd5AndDesEncryptor::encrypt(message, _password, SALT);
+        return PbeMd5AndDesEncryptor::encrypt(message, *_key);
     } catch (const std::exception &ex) {
         BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in encrypting string: ") + ex.what()));
     }
@@ -40,11 +64,82 @@ std::string SharedSecretTextCryptoProvider::encrypt(const std::string& message)
 
 std::string SharedSecretTextCryptoProvider::decrypt(const std::string& encryptedMessage) const {
     try {
-        return PbeMd5AndDesEncryptor::decrypt(encryptedMessage, _password, SALT);
+        return PbeMd5AndDesEncryptor::decrypt(encryptedMessage, *_key);
     } catch (const std::exception& ex) {
         BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in decrypting string: ") + ex.what()));
     }
 }
 
 
+size_t SharedSecretTextCryptoProvider::encryptTo(boost::string_ref message, char* out, size_t capacity) const {
+    if (capacity < maxEncryptedSize(message.size())) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in encrypting string: output buffer is too small"));
+    }
+    return PbeMd5AndDesEncryptor::encrypt(message, *_key, out);
+}
+
+
+size_t SharedSecretTextCryptoProvider::decryptTo(boost::string_ref encryptedMessage, char* out,
+        size_t capacity) const {
+    if (capacity < maxDecryptedSize(encryptedMessage.size())) {
+        BOOST_THROW_EXCEPTION(SecurityException("Error in decrypting string: output buffer is too small"));
+    }
+    try {
+        return PbeMd5AndDesEncryptor::decrypt(encryptedMessage, *_key, out);
+    } catch (const std::exception& ex) {
+        BOOST_THROW_EXCEPTION(SecurityException(std::string("Error in decrypting string: ") + ex.what()));
+    }
+}
+
+
+BatchErrors SharedSecretTextCryptoProvider::encryptBatch(const std::string* messages, std::string* results,
+        size_t count) const {
+    return transformBatch(&PbeMd5AndDesEncryptor::encryptBatch, "Error in encrypting string: ",
+                          messages, results, count);
+}
+
+
+BatchErrors SharedSecretTextCryptoProvider::decryptBatch(const std::string* encryptedMessages, std::string* results,
+        size_t count) const {
+    return transformBatch(&PbeMd5AndDesEncryptor::decryptBatch, "Error in decrypting string: ",
+                          encryptedMessages, results, count);
+}
+
+
+BatchErrors SharedSecretTextCryptoProvider::transformBatch(Transform transform, const char* errorPrefix,
+        const std::string* inputs, std::string* results, size_t count) const {
+    const PbeMd5AndDesEncryptor::PbeMd5AndDesKey& key = *_key;
+    BatchErrors errors;
+
+    //a single chunk runs on the calling thread, without touching a pool
+    if (count <= BATCH_GRAIN) {
+        BatchErrors chunkErrors = transform(inputs, results, count, key);
+        for (BatchErrors::const_iterator itr = chunkErrors.begin(); itr != chunkErrors.end(); ++itr) {
+            errors.push_back(BatchItemError(itr->index, errorPrefix + itr->message));
+        }
+        return errors;
+    }
+
+    //the process wide pool is started by the first batch that needs it
+    ::ezbake::common::utils::ThreadPool& pool = _pool ? *_pool : ::ezbake::common::utils::ThreadPool::instance();
+    std::mutex errorsMutex;
+
+    pool.parallelFor(count, BATCH_GRAIN, [&](size_t begin, size_t end) {
+        BatchErrors chunkErrors = transform(inputs + begin, results + begin, end - begin, key);
+        if (chunkErrors.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(errorsMutex);
+        for (BatchErrors::const_iterator itr = chunkErrors.begin(); itr != chunkErrors.end(); ++itr) {
+            errors.push_back(BatchItemError(begin + itr->index, errorPrefix + itr->message));
+        }
+    });
+
+    //chunks complete out of order
+    std::sort(errors.begin(), errors.end(), [](const BatchItemError& lhs, const BatchItemError& rhs) {
+        return lhs.index < rhs.index;
+    });
+    return errors;
+}
+
 }}} // namespace ezbake::common::security
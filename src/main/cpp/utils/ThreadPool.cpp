@@ -0,0 +1,163 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include <ezbake/common/utils/ThreadPool.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace ezbake { namespace common { namespace utils {
+
+namespace {
+
+/*
+ * State shared between the chunks of one parallelFor() call. Chunks claim work
+ * from a common cursor, so the calling thread keeps working even when every
+ * worker is busy with other tasks.
+ */
+struct ParallelForState {
+    ParallelForState(size_t count, size_t grain, const std::function<void (size_t, size_t)>& fn)
+        : count(count), grain(grain), fn(fn), next(0), remaining((count + grain - 1) / grain) {}
+
+    //runs chunks until none are left unclaimed
+    void drain() {
+        for (;;) {
+            size_t begin = next.fetch_add(grain);
+            if (begin >= count) {
+                return;
+            }
+            try {
+                fn(begin, std::min(count, begin + grain));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+            if (remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return remaining.load() == 0; });
+    }
+
+    const size_t count;
+    const size_t grain;
+    const std::function<void (size_t, size_t)>& fn;
+    std::atomic<size_t> next;
+    std::atomic<size_t> remaining;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+} // namespace
+
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+
+ThreadPool::ThreadPool(size_t threads) :
+    _stopping(false)
+{
+    threads = std::max<size_t>(threads, 1);
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::thread(&ThreadPool::run, this));
+    }
+}
+
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _available.notify_all();
+    for (std::vector<std::thread>::iterator itr = _workers.begin(); itr != _workers.end(); ++itr) {
+        itr->join();
+    }
+}
+
+
+void ThreadPool::submit(const Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+    _available.notify_one();
+}
+
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void (size_t, size_t)>& fn) {
+    grain = std::max<size_t>(grain, 1);
+    if (count <= grain) {
+        if (count > 0) {
+            fn(0, count);
+        }
+        return;
+    }
+
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>(count, grain, fn);
+    size_t helpers = std::min(_workers.size(), (count + grain - 1) / grain - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        //helpers that start after all chunks are claimed return immediately
+        submit([state]() { state->drain(); });
+    }
+    state->drain();
+    state->wait();
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+
+void ThreadPool::run() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _available.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            task.swap(_tasks.front());
+            _tasks.pop_front();
+        }
+        try {
+            task();
+        } catch (...) {
+            //submitted tasks report their own failures
+        }
+    }
+}
+
+}}} // namespace ::ezbake::common::utils
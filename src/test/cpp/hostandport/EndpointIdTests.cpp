@@ -0,0 +1,96 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointIdTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "../AllTests.h"
+
+#include <ezbake/common/EndpointId.h>
+#include <ezbake/common/lrucache/LRUCache.h>
+#include <set>
+#include <unordered_set>
+#include <boost/thread.hpp>
+
+
+class EndpointIdTest : public ::testing::Test {
+public:
+    EndpointIdTest() {}
+    virtual ~EndpointIdTest() {}
+};
+
+
+using namespace ::ezbake::common;
+
+TEST_F(EndpointIdTest, InternAndConvert) {
+    EndpointId id = EndpointId::fromParts("zk1.example.com", 2181);
+    EXPECT_EQ(id, EndpointId::fromHostAndPort(HostAndPort::fromString("zk1.example.com:2181")));
+    EXPECT_EQ(id.getHostId(), EndpointId::fromHost("zk1.example.com").getHostId());
+    EXPECT_NE(id, EndpointId::fromHost("zk1.example.com"));
+    EXPECT_NE(id, EndpointId::fromParts("zk1.example.com", 2182));
+    EXPECT_NE(id, EndpointId::fromParts("zk2.example.com", 2181));
+
+    EXPECT_EQ(std::string("zk1.example.com"), id.getHostText());
+    EXPECT_EQ(2181u, id.getPort());
+    EXPECT_EQ(HostAndPort::fromParts("zk1.example.com", 2181), id.toHostAndPort());
+    EXPECT_EQ(std::string("[::1]:0"), EndpointId::fromParts("::1", 0).toString());
+
+    EXPECT_FALSE(EndpointId().hasPort());
+    EXPECT_EQ(std::string(""), EndpointId().getHostText());
+    EXPECT_EQ(80u, EndpointId::fromHost("web").getPortOrDefault(80));
+    EXPECT_THROW(EndpointId::fromHost("web").getPort(), std::invalid_argument);
+    EXPECT_THROW(EndpointId::fromParts("web", 65536), std::out_of_range);
+}
+
+
+TEST_F(EndpointIdTest, HashedContainers) {
+    std::unordered_set<EndpointId> ids;
+    for (unsigned int port = 0; port < 1000; ++port) {
+        ids.insert(EndpointId::fromParts("host", port));
+        ids.insert(EndpointId::fromParts("host", port));
+    }
+    EXPECT_EQ(1000u, ids.size());
+
+    ezbake::common::lrucache::LRUCache<EndpointId, int> cache(10);
+    cache.put(EndpointId::fromParts("cache", 1), 1);
+    EXPECT_EQ(1, *cache.get(EndpointId::fromParts("cache", 1)));
+    EXPECT_FALSE(cache.get(EndpointId::fromParts("cache", 2)));
+}
+
+
+TEST_F(EndpointIdTest, ConcurrentIntern) {
+    const int THREADS = 4;
+    std::vector<uint32_t> ids[THREADS];
+    boost::thread_group threads;
+
+    for (int t = 0; t < THREADS; ++t) {
+        std::vector<uint32_t>* out = &ids[t];
+        threads.create_thread([out]() {
+            for (int i = 0; i < 500; ++i) {
+                out->push_back(EndpointId::fromHost("concurrent" + std::to_string(static_cast<long long>(i))).getHostId());
+            }
+        });
+    }
+    threads.join_all();
+
+    for (int t = 1; t < THREADS; ++t) {
+        EXPECT_EQ(ids[0], ids[t]);
+    }
+    std::set<uint32_t> distinct(ids[0].begin(), ids[0].end());
+    EXPECT_EQ(500u, distinct.size());
+}
@@ -0,0 +1,146 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * EndpointResolverTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "../AllTests.h"
+
+#include <ezbake/common/EndpointResolver.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+using namespace ::ezbake::common;
+
+
+class EndpointResolverTest : public ::testing::Test {
+public:
+    typedef BasicEndpointResolver<lrucache::ManualClock> ManualResolver;
+
+    EndpointResolverTest() : lookups(new std::atomic<int>(0)), gate(new std::promise<void>()) {}
+    virtual ~EndpointResolverTest() {}
+
+    //counts lookups and holds them until the gate opens; "missing" fails to resolve
+    ManualResolver::Lookup gatedLookup() {
+        std::shared_ptr<std::atomic<int> > counter = lookups;
+        std::shared_future<void> opened = gate->get_future().share();
+        return [counter, opened](const std::string& host, SocketAddresses& addresses) {
+            ++*counter;
+            opened.wait();
+            if ("missing" == host) {
+                return EAI_NONAME;
+            }
+            SocketAddress address;
+            memset(&address.storage, 0, sizeof(address.storage));
+            sockaddr_in* in = reinterpret_cast<sockaddr_in*>(&address.storage);
+            in->sin_family = AF_INET;
+            in->sin_addr.s_addr = htonl(0x0A000001);
+            address.length = sizeof(sockaddr_in);
+            addresses.push_back(address);
+            return 0;
+        };
+    }
+
+    static void waitIdle(ManualResolver& resolver) {
+        while (resolver.pending()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::shared_ptr<std::atomic<int> > lookups;
+    std::unique_ptr<std::promise<void> > gate;
+};
+
+
+TEST_F(EndpointResolverTest, ResolveLocalhost) {
+    EndpointResolver resolver;
+
+    SocketAddresses addresses = resolver.resolve(HostAndPort::fromString("localhost:8080")).get();
+    ASSERT_FALSE(addresses.empty());
+    for (SocketAddresses::const_iterator itr = addresses.begin(); itr != addresses.end(); ++itr) {
+        EXPECT_EQ(8080u, itr->port());
+    }
+    ASSERT_TRUE(resolver.cached(HostAndPort::fromString("localhost:9090")).is_initialized());
+    EXPECT_EQ(9090u, resolver.cached(HostAndPort::fromString("localhost:9090"))->front().port());
+
+    addresses = resolver.resolve(HostAndPort::fromString("127.0.0.1:80")).get();
+    ASSERT_EQ(1u, addresses.size());
+    EXPECT_EQ(std::string("127.0.0.1:80"), addresses[0].toString());
+
+    addresses = resolver.resolve(HostAndPort::fromString("[::1]:80")).get();
+    ASSERT_EQ(1u, addresses.size());
+    EXPECT_EQ(std::string("[::1]:80"), addresses[0].toString());
+
+    resolver.invalidate(HostAndPort::fromString("localhost"));
+    EXPECT_FALSE(resolver.cached(HostAndPort::fromString("localhost")).is_initialized());
+}
+
+
+TEST_F(EndpointResolverTest, CoalesceAndCache) {
+    ManualResolver resolver(2, 100, 300, 30, 60, gatedLookup());
+
+    std::vector<std::future<SocketAddresses> > results;
+    for (unsigned int port = 1; port <= 10; ++port) {
+        results.push_back(resolver.resolve(HostAndPort::fromParts("service", port)));
+    }
+    EXPECT_EQ(1u, resolver.pending());
+    gate->set_value();
+
+    for (unsigned int port = 1; port <= 10; ++port) {
+        SocketAddresses addresses = results[port - 1].get();
+        ASSERT_EQ(1u, addresses.size());
+        EXPECT_EQ("10.0.0.1:" + std::to_string(static_cast<long long>(port)), addresses[0].toString());
+    }
+    EXPECT_EQ(1, lookups->load());
+
+    //cached, then refreshed in the background inside the refresh window, then expired
+    resolver.clock().advance(200);
+    EXPECT_EQ(1u, resolver.resolve(HostAndPort::fromString("service:1")).get().size());
+    EXPECT_EQ(1, lookups->load());
+
+    resolver.clock().advance(50);
+    EXPECT_EQ(1u, resolver.resolve(HostAndPort::fromString("service:1")).get().size());
+    waitIdle(resolver);
+    EXPECT_EQ(2, lookups->load());
+
+    resolver.clock().advance(301);
+    EXPECT_FALSE(resolver.cached(HostAndPort::fromString("service")).is_initialized());
+}
+
+
+TEST_F(EndpointResolverTest, NegativeCache) {
+    ManualResolver resolver(1, 100, 300, 30, 60, gatedLookup());
+    gate->set_value();
+
+    EXPECT_THROW(resolver.resolve(HostAndPort::fromString("missing:80")).get(), ResolveException);
+    EXPECT_THROW(resolver.resolve(HostAndPort::fromString("missing:80")).get(), ResolveException);
+    EXPECT_EQ(1, lookups->load());
+    EXPECT_FALSE(resolver.cached(HostAndPort::fromString("missing")).is_initialized());
+
+    resolver.clock().advance(30);
+    try {
+        resolver.resolve(HostAndPort::fromString("missing:80")).get();
+        FAIL() << "expected ResolveException";
+    } catch (const ResolveException& e) {
+        EXPECT_EQ(EAI_NONAME, e.error());
+    }
+    EXPECT_EQ(2, lookups->load());
+}
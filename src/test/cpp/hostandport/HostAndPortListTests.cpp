@@ -0,0 +1,97 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * HostAndPortListTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "../AllTests.h"
+
+#include <ezbake/common/HostAndPortList.h>
+
+
+class HostAndPortListTest : public ::testing::Test {
+public:
+    HostAndPortListTest() {}
+    virtual ~HostAndPortListTest() {}
+};
+
+
+using namespace ::ezbake::common;
+
+TEST_F(HostAndPortListTest, ParseConnectString) {
+    HostAndPortList list = HostAndPortList::parse("zk1:2181, zk2 ,[::1]:2182,,zk3:2183,", 2181);
+    ASSERT_EQ(4u, list.hosts().size());
+    EXPECT_FALSE(list.hasErrors());
+    EXPECT_EQ(HostAndPort::fromParts("zk1", 2181), list.hosts()[0]);
+    EXPECT_EQ(HostAndPort::fromParts("zk2", 2181), list.hosts()[1]);
+    EXPECT_EQ(HostAndPort::fromParts("::1", 2182), list.hosts()[2]);
+    EXPECT_EQ(HostAndPort::fromParts("zk3", 2183), list.hosts()[3]);
+    EXPECT_EQ("zk1:2181,zk2:2181,[::1]:2182,zk3:2183", list.toString());
+
+    EXPECT_FALSE(HostAndPortList::parse("zk1").hosts()[0].hasPort());
+    EXPECT_TRUE(HostAndPortList::parse("").hosts().empty());
+    EXPECT_THROW(HostAndPortList::parse("zk1", 65536), std::out_of_range);
+}
+
+
+TEST_F(HostAndPortListTest, LongListsAndErrors) {
+    //hundreds of hosts, so most delimiters are found by the vector scan
+    std::string str;
+    for (int i = 0; i < 500; ++i) {
+        str += "host" + std::to_string(static_cast<long long>(i % 100)) + ".example.com:" +
+               std::to_string(static_cast<long long>(2181 + (i / 100) % 2)) + ",";
+    }
+    size_t badOffset = str.size();
+    str += "bad:port,[::2:2181";
+
+    HostAndPortList list = HostAndPortList::parse(str);
+    EXPECT_EQ(500u, list.hosts().size());
+    ASSERT_EQ(2u, list.errors().size());
+    EXPECT_EQ(badOffset, list.errors()[0].offset);
+    EXPECT_EQ(8u, list.errors()[0].length);
+    EXPECT_EQ(HostAndPort::INVALID_PORT, list.errors()[0].error);
+    EXPECT_EQ(HostAndPort::UNTERMINATED_BRACKET, list.errors()[1].error);
+
+    list.sortAndDeduplicate();
+    ASSERT_EQ(200u, list.hosts().size());
+    for (size_t i = 1; i < list.hosts().size(); ++i) {
+        EXPECT_LT(list.hosts()[i - 1], list.hosts()[i]);
+    }
+
+    HostAndPortList unported = HostAndPortList::parse("b,a,b,a:1");
+    unported.sortAndDeduplicate();
+    EXPECT_EQ("a:,a:1,b:", unported.toString());
+}
+
+
+TEST_F(HostAndPortListTest, ChrootAndAmbiguousEntries) {
+    HostAndPortList list = HostAndPortList::parse("zk1:2181,zk2:2181/app/config");
+    EXPECT_FALSE(list.hasErrors());
+    ASSERT_EQ(2u, list.hosts().size());
+    EXPECT_EQ(HostAndPort::fromParts("zk2", 2181), list.hosts()[1]);
+    EXPECT_EQ("/app/config", list.chroot());
+    EXPECT_EQ("zk1:2181,zk2:2181/app/config", list.toString());
+    EXPECT_EQ("", HostAndPortList::parse("zk1:2181").chroot());
+
+    list = HostAndPortList::parse("zk1:2181:2888,:2181,::1");
+    ASSERT_EQ(1u, list.hosts().size());
+    EXPECT_EQ(HostAndPort::fromHost("::1"), list.hosts()[0]);
+    ASSERT_EQ(2u, list.errors().size());
+    EXPECT_EQ(HostAndPort::INVALID_IPV6_LITERAL, list.errors()[0].error);
+    EXPECT_EQ(HostAndPort::EMPTY_HOST, list.errors()[1].error);
+}
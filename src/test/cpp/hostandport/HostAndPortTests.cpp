@@ -50,4 +50,58 @@ TEST_F(HostAndPortTest, CreationAndValidation) {
     EXPECT_EQ(HostAndPort::fromString("localhost"), HostAndPort::fromString("localhost"));
 
     EXPECT_NE(HostAndPort::fromString("localhost:1234"), HostAndPort::fromString("localhost"));
+
+    //equal hosts without ports are equivalent, as std::sort requires
+    EXPECT_FALSE(HostAndPort::fromString("localhost") < HostAndPort::fromString("localhost"));
+}
+
+TEST_F(HostAndPortTest, ParseIPv6AndErrors) {
+    HostAndPort::Parsed parsed;
+    std::string text = "[::1]:9090";
+    ASSERT_EQ(HostAndPort::PARSE_OK, HostAndPort::parse(text, parsed));
+    EXPECT_EQ("::1", parsed.host);
+    EXPECT_EQ(text.data() + 1, parsed.host.data());
+    EXPECT_TRUE(parsed.hasPort);
+    EXPECT_EQ(9090u, parsed.port);
+
+    EXPECT_EQ(HostAndPort::fromParts("::1", 9090), HostAndPort::fromString("[::1]:9090"));
+    EXPECT_EQ(std::string("[::1]:9090"), HostAndPort::fromString("[::1]:9090").toString());
+    EXPECT_EQ(HostAndPort::fromHost("fe80::1"), HostAndPort::fromString("fe80::1"));
+    EXPECT_EQ(HostAndPort::fromHost("fe80::1"), HostAndPort::fromString("[fe80::1]"));
+    EXPECT_EQ(HostAndPort::fromHost("localhost"), HostAndPort::fromString("localhost:"));
+    EXPECT_EQ(65535u, HostAndPort::fromString("localhost:65535").getPort());
+
+    EXPECT_EQ(HostAndPort::UNTERMINATED_BRACKET, HostAndPort::parse("[::1:80", parsed));
+    EXPECT_EQ(HostAndPort::UNEXPECTED_CHARACTERS, HostAndPort::parse("[::1]80", parsed));
+    EXPECT_EQ(HostAndPort::INVALID_PORT, HostAndPort::parse("localhost:80a", parsed));
+    EXPECT_EQ(HostAndPort::INVALID_PORT, HostAndPort::parse("localhost:-1", parsed));
+    EXPECT_EQ(HostAndPort::PORT_OUT_OF_RANGE, HostAndPort::parse("localhost:65536", parsed));
+    EXPECT_EQ(HostAndPort::PORT_OUT_OF_RANGE, HostAndPort::parse("localhost:99999999999999999999", parsed));
+
+    HostAndPort::ParseError error;
+    EXPECT_FALSE(HostAndPort::tryFromString("localhost:http", error));
+    EXPECT_EQ(HostAndPort::INVALID_PORT, error);
+    EXPECT_THROW(HostAndPort::fromString("localhost:http"), std::invalid_argument);
+    EXPECT_THROW(HostAndPort::fromString("localhost:70000"), std::out_of_range);
+
+    EXPECT_EQ(8080u, HostAndPort::fromHost("localhost").getPortOrDefault(8080));
+    EXPECT_EQ(1234u, HostAndPort::fromString("localhost:1234").getPortOrDefault(8080));
+}
+
+TEST_F(HostAndPortTest, ParseRejectsAmbiguousHosts) {
+    HostAndPort::Parsed parsed;
+    EXPECT_EQ(HostAndPort::INVALID_IPV6_LITERAL, HostAndPort::parse("zk1:2181:2888", parsed));
+    EXPECT_EQ(HostAndPort::INVALID_IPV6_LITERAL, HostAndPort::parse("host::80", parsed));
+    EXPECT_EQ(HostAndPort::INVALID_IPV6_LITERAL, HostAndPort::parse("1:2:3:4:5:6:7:8:9", parsed));
+    EXPECT_THROW(HostAndPort::fromString("zk1:2181:2888"), std::invalid_argument);
+
+    EXPECT_EQ(HostAndPort::PARSE_OK, HostAndPort::parse("::ffff:10.0.0.1", parsed));
+    EXPECT_FALSE(parsed.hasPort);
+    EXPECT_EQ(HostAndPort::PARSE_OK, HostAndPort::parse("fe80::1%eth0", parsed));
+    EXPECT_EQ("fe80::1%eth0", parsed.host);
+
+    EXPECT_EQ(HostAndPort::EMPTY_HOST, HostAndPort::parse(":80", parsed));
+    EXPECT_EQ(HostAndPort::EMPTY_HOST, HostAndPort::parse("[]:80", parsed));
+    EXPECT_EQ(HostAndPort::EMPTY_HOST, HostAndPort::parse("", parsed));
+    EXPECT_THROW(HostAndPort::fromString(":80"), std::invalid_argument);
 }
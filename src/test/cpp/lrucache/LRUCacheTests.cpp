@@ -22,6 +22,7 @@
 #include "../AllTests.h"
 #include <ezbake/common/lrucache/LRUCache.h>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 TEST(LRUCacheTest, HandlesBasicPutAndGet) {
@@ -174,3 +175,77 @@ TEST(LRUCacheTest, MultiMappedKeys) {
     EXPECT_TRUE(cache.containsValue("Value3"));
 }
 
+
+TEST(LRUCacheTest, PutIfAbsent) {
+    ezbake::common::lrucache::LRUCache<std::string, std::string> cache(2);
+
+    EXPECT_FALSE(cache.putIfAbsent("Key1", "Value1"));
+    EXPECT_EQ("Value1", cache.putIfAbsent("Key1", "Value2").get());
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.valueRange("Key1"));
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+
+    //a hit counts as an access, so Key2 is evicted rather than Key1
+    cache.put("Key2", "Value2");
+    EXPECT_EQ("Value1", cache.putIfAbsent("Key1", "Value3").get());
+    cache.put("Key3", "Value3");
+    EXPECT_TRUE(cache.containsKey("Key1"));
+    EXPECT_FALSE(cache.containsKey("Key2"));
+}
+
+TEST(LRUCacheTest, Replace) {
+    ezbake::common::lrucache::LRUCache<std::string, std::string> cache;
+
+    cache.put("Key1", "Value11");
+    cache.put("Key1", "Value12");
+    EXPECT_EQ(static_cast<unsigned int>(2), cache.valueRange("Key1"));
+
+    cache.replace("Key1", "Value13");
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.valueRange("Key1"));
+    EXPECT_EQ("Value13", cache.get("Key1").get());
+}
+
+TEST(LRUCacheTest, LeastRecentlyUsedOfMultiMappedKey) {
+    ezbake::common::lrucache::LRUCache<std::string, std::string> cache(5);
+
+    cache.put("Key1", "Value11");
+    cache.put("Key1", "Value12");
+    cache.put("Key1", "Value13");
+
+    //each get returns the least recently used value and makes it the most recently used
+    EXPECT_EQ("Value11", cache.get("Key1").get());
+    EXPECT_EQ("Value12", cache.get("Key1").get());
+    EXPECT_EQ("Value13", cache.get("Key1").get());
+    EXPECT_EQ("Value11", cache.get("Key1").get());
+}
+
+TEST(LRUCacheTest, FifoEviction) {
+    ezbake::common::lrucache::FifoCache<std::string, std::string> cache(2);
+
+    cache.put("Key1", "Value1");
+    cache.put("Key2", "Value2");
+
+    //reads do not change the eviction order
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+    cache.put("Key3", "Value3");
+
+    EXPECT_FALSE(cache.containsKey("Key1"));
+    EXPECT_TRUE(cache.containsKey("Key2"));
+    EXPECT_TRUE(cache.containsKey("Key3"));
+}
+
+TEST(LRUCacheTest, Unsynchronized) {
+    typedef ezbake::common::lrucache::LRUCache<std::string, std::string> DefaultCache;
+    EXPECT_TRUE(std::has_virtual_destructor<DefaultCache>::value);
+
+    ezbake::common::lrucache::UnsynchronizedLRUCache<std::string, std::string> cache(2);
+
+    cache.put("Key1", "Value1");
+    cache.put("Key2", "Value2");
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+    cache.put("Key3", "Value3");
+
+    EXPECT_TRUE(cache.isFull());
+    EXPECT_TRUE(cache.containsKey("Key1"));
+    EXPECT_FALSE(cache.containsKey("Key2"));
+    EXPECT_TRUE(cache.containsKey("Key3"));
+}
@@ -21,8 +21,11 @@
 
 #include "../AllTests.h"
 #include <ezbake/common/lrucache/LRUTimedCache.h>
+#include <algorithm>
+#include <set>
 #include <string>
 #include <boost/thread.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <stdexcept>
@@ -31,6 +34,7 @@
 using namespace ezbake::common::lrucache;
 
 typedef LRUTimedCache<std::string, std::string> TestCache;
+typedef LRUTimedCache<std::string, std::string, ManualClock> ManualClockCache;
 
 TEST(LRUTimedCacheTest, GetAfterExpiration) {
     TestCache cache(5, 2);
@@ -190,3 +194,180 @@ TEST(LRUTimedCacheTest, RawPointerContainer) {
     EXPECT_EQ("Value2", *(reinterpret_cast<std::string*>(cache.get("Key2").get())));
 }
 
+
+TEST(LRUTimedCacheTest, PinnedEntryDoesNotExpire) {
+    ManualClockCache cache(5, 1);
+
+    cache.put("Key1", "Value1", CacheEntryHeader::PINNED);
+    cache.put("Key2", "Value2");
+
+    cache.clock().advance(1);
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+    EXPECT_FALSE(cache.get("Key2"));
+}
+
+TEST(LRUTimedCacheTest, ExpirationJitter) {
+    TestCache cache(100, 100);
+    cache.setRandomSeed(42);
+    cache.setExpirationJitter(50);
+    EXPECT_EQ(static_cast<uint64_t>(50), cache.expirationJitter());
+
+    for (int i = 0; i < 50; ++i) {
+        cache.put("Key", boost::lexical_cast<std::string>(i));
+    }
+
+    std::set<uint32_t> deadlines;
+    uint32_t earliest = CacheEntryHeader::NO_DEADLINE, latest = 0;
+    BOOST_FOREACH(const TestCache::CacheValueType& entry, cache.remove("Key")) {
+        deadlines.insert(entry.deadline());
+        earliest = std::min(earliest, entry.deadline());
+        latest = std::max(latest, entry.deadline());
+    }
+    EXPECT_LT(static_cast<size_t>(10), deadlines.size());
+    EXPECT_GE(static_cast<uint32_t>(51), latest - earliest);
+
+    //jitter can never consume the whole expiration
+    cache.setExpirationJitter(500);
+    EXPECT_EQ(static_cast<uint64_t>(99), cache.expirationJitter());
+}
+
+TEST(LRUTimedCacheTest, EarlyExpiration) {
+    TestCache cache(5, 60);
+    cache.setRandomSeed(42);
+
+    cache.put("Key1", "Value1");
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+
+    //a window far larger than the expiration makes early expiry a near certainty
+    cache.setEarlyExpiration(1000000);
+    EXPECT_FALSE(cache.get("Key1"));
+
+    cache.setEarlyExpiration(0);
+    cache.put("Key1", "Value1");
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+}
+
+TEST(LRUTimedCacheTest, GenerationalExpiration) {
+    ManualClockCache cache(5, 2, ManualClockCache::GENERATIONAL_EXPIRATION, 2);
+    EXPECT_EQ(ManualClockCache::GENERATIONAL_EXPIRATION, cache.expirationMode());
+
+    cache.put("Key1", "Value1");
+    cache.put("Key2", "Value2", CacheEntryHeader::PINNED);
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+    EXPECT_EQ("Key1", cache.getKey("Value1").get());
+
+    cache.clock().advance(1);
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+
+    cache.clock().advance(1);
+    EXPECT_FALSE(cache.get("Key1"));
+    EXPECT_EQ("Value2", cache.get("Key2").get());
+}
+
+TEST(LRUTimedCacheTest, GenerationalReclaimOnPut) {
+    ManualClockCache cache(5, 1, ManualClockCache::GENERATIONAL_EXPIRATION, 1);
+
+    cache.put("Key1", "Value1");
+    cache.put("Key2", "Value2");
+    EXPECT_EQ(static_cast<unsigned int>(2), cache.size());
+
+    //aged out entries at the least recently used end are reclaimed on put
+    cache.clock().advance(1);
+    cache.put("Key3", "Value3");
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.size());
+    EXPECT_EQ("Value3", cache.get("Key3").get());
+}
+
+TEST(LRUTimedCacheTest, GenerationalDropsTouchedExpiredEntries) {
+    ManualClockCache cache(3, 8, ManualClockCache::GENERATIONAL_EXPIRATION, 8);
+
+    cache.put("KeyA", "ValueA");
+    cache.clock().advance(5);
+    cache.put("KeyB", "ValueB");
+
+    //reading KeyA moves it ahead of KeyB in the least recently used order
+    EXPECT_EQ("ValueA", cache.get("KeyA").get());
+
+    //KeyA ages out; its generation is dropped rather than evicting live KeyB
+    cache.clock().advance(4);
+    cache.put("KeyC", "ValueC");
+    cache.put("KeyD", "ValueD");
+    EXPECT_EQ(static_cast<unsigned int>(3), cache.size());
+    EXPECT_FALSE(cache.get("KeyA"));
+    EXPECT_EQ("ValueB", cache.get("KeyB").get());
+    EXPECT_EQ("ValueC", cache.get("KeyC").get());
+    EXPECT_EQ("ValueD", cache.get("KeyD").get());
+}
+
+TEST(LRUTimedCacheTest, GenerationalCompactionKeepsWrittenKey) {
+    ManualClockCache cache(2, 8, ManualClockCache::GENERATIONAL_EXPIRATION, 8);
+
+    //evictions grow the bucket until it is compacted while K5 is written
+    cache.put("K1", "V1");
+    cache.put("K2", "V2");
+    cache.put("K3", "V3");
+    cache.put("K4", "V4");
+    cache.put("K5", "V5");
+
+    //the lookup drops the aged out bucket, which must still name K5
+    cache.clock().advance(100);
+    EXPECT_FALSE(cache.get("K1"));
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_FALSE(cache.get("K5"));
+}
+
+TEST(LRUTimedCacheTest, PutIfAbsent) {
+    ManualClockCache cache(5, 10);
+
+    EXPECT_FALSE(cache.putIfAbsent("Key1", "Value1"));
+    EXPECT_EQ("Value1", cache.putIfAbsent("Key1", "Value2").get());
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.valueRange("Key1"));
+
+    //an expired value does not count as present
+    cache.clock().advance(10);
+    EXPECT_FALSE(cache.putIfAbsent("Key1", "Value3"));
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.valueRange("Key1"));
+    EXPECT_EQ("Value3", cache.get("Key1").get());
+}
+
+TEST(LRUTimedCacheTest, Replace) {
+    ManualClockCache cache(5, 10);
+
+    cache.put("Key1", "Value11");
+    cache.put("Key1", "Value12");
+    cache.clock().advance(5);
+
+    //the replacement gets a fresh deadline
+    cache.replace("Key1", "Value13");
+    EXPECT_EQ(static_cast<unsigned int>(1), cache.valueRange("Key1"));
+    cache.clock().advance(5);
+    EXPECT_EQ("Value13", cache.get("Key1").get());
+}
+
+TEST(LRUTimedCacheTest, ManualClock) {
+    ManualClockCache cache(5, 3600);
+    cache.clock().set(1000);
+
+    cache.put("Key1", "Value1");
+    cache.clock().advance(3599);
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+    EXPECT_TRUE(cache.containsValue("Value1"));
+
+    cache.clock().advance(1);
+    EXPECT_FALSE(cache.containsValue("Value1"));
+    EXPECT_FALSE(cache.get("Key1"));
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(LRUTimedCacheTest, Unsynchronized) {
+    UnsynchronizedLRUTimedCache<std::string, std::string, ManualClock> cache(2, 10);
+
+    cache.put("Key1", "Value1");
+    cache.clock().advance(5);
+    cache.put("Key2", "Value2");
+    EXPECT_EQ("Value1", cache.get("Key1").get());
+
+    cache.clock().advance(5);
+    EXPECT_FALSE(cache.get("Key1"));
+    EXPECT_EQ("Value2", cache.get("Key2").get());
+}
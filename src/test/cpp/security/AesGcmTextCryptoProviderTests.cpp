@@ -0,0 +1,102 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AesGcmTextCryptoProviderTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/AesGcmTextCryptoProvider.h>
+#include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
+#include <boost/make_shared.hpp>
+
+using namespace ::ezbake::common::security;
+
+
+class AesGcmTextCryptoProviderTest : public ::testing::Test {
+public:
+    AesGcmTextCryptoProviderTest() {}
+    virtual ~AesGcmTextCryptoProviderTest() {}
+};
+
+
+TEST_F(AesGcmTextCryptoProviderTest, testEncryptDecrypt) {
+    std::string plainText = "My test message";
+    boost::shared_ptr<TextCryptoProvider> provider = boost::make_shared<AesGcmTextCryptoProvider>("swordfish");
+
+    std::string encrypted = provider->encrypt(plainText);
+    EXPECT_TRUE(AesGcmTextCryptoProvider::isVersioned(encrypted));
+    EXPECT_EQ(plainText, provider->decrypt(encrypted)) << "The decrypted text does not match the plain text!";
+
+    //every message gets a fresh nonce
+    EXPECT_NE(encrypted, provider->encrypt(plainText));
+
+    EXPECT_EQ("", provider->decrypt(provider->encrypt("")));
+}
+
+
+TEST_F(AesGcmTextCryptoProviderTest, testDecryptLegacy) {
+    std::string plainText = "My test message";
+    SharedSecretTextCryptoProvider legacy("swordfish");
+    AesGcmTextCryptoProvider provider("swordfish");
+
+    std::string encrypted = legacy.encrypt(plainText);
+    EXPECT_FALSE(AesGcmTextCryptoProvider::isVersioned(encrypted));
+    EXPECT_EQ(plainText, provider.decrypt(encrypted));
+}
+
+
+TEST_F(AesGcmTextCryptoProviderTest, testRejectsTamperedMessages) {
+    AesGcmTextCryptoProvider provider("swordfish");
+    AesGcmTextCryptoProvider other("not swordfish");
+
+    std::string encrypted = provider.encrypt("My test message");
+    EXPECT_THROW(other.decrypt(encrypted), SecurityException);
+
+    std::string tampered = encrypted;
+    size_t position = AesGcmTextCryptoProvider::VERSION_HEADER.length() + 20;
+    tampered[position] = (tampered[position] == 'A') ? 'B' : 'A';
+    EXPECT_THROW(provider.decrypt(tampered), SecurityException);
+
+    EXPECT_THROW(provider.decrypt(AesGcmTextCryptoProvider::VERSION_HEADER + "AAAA"), SecurityException);
+}
+
+
+TEST_F(AesGcmTextCryptoProviderTest, testCallerBuffers) {
+    AesGcmTextCryptoProvider provider("swordfish");
+    SharedSecretTextCryptoProvider legacy("swordfish");
+
+    for (size_t length = 0; length < 40; ++length) {
+        std::string plainText(length, static_cast<char>('a' + length));
+
+        std::string encrypted;
+        provider.appendEncrypted(plainText, encrypted);
+        EXPECT_EQ(provider.maxEncryptedSize(length), encrypted.length());
+        EXPECT_EQ(plainText, provider.decrypt(encrypted));
+
+        std::string decrypted;
+        provider.appendDecrypted(provider.encrypt(plainText), decrypted);
+        provider.appendDecrypted(legacy.encrypt(plainText), decrypted);
+        EXPECT_EQ(plainText + plainText, decrypted);
+    }
+
+    char small[16];
+    EXPECT_THROW(provider.encryptTo("My test message", small, sizeof(small)), SecurityException);
+    EXPECT_THROW(provider.decryptTo("$aesgcm1$AAAA", small, sizeof(small)), SecurityException);
+}
@@ -0,0 +1,167 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * AsyncTextCryptoProviderTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/AsyncTextCryptoProvider.h>
+#include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+using namespace ::ezbake::common::security;
+
+
+/*
+ * Records the batch sizes reaching the real provider, holding the first batch
+ * until released so requests pile up behind it
+ */
+class GatedTextCryptoProvider : public SharedSecretTextCryptoProvider {
+public:
+    GatedTextCryptoProvider() : SharedSecretTextCryptoProvider("swordfish"), gate(release.get_future()) {}
+
+    virtual BatchErrors encryptBatch(const std::string* messages, std::string* results, size_t count) const {
+        record(count);
+        return SharedSecretTextCryptoProvider::encryptBatch(messages, results, count);
+    }
+
+    void record(size_t count) const {
+        bool first;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            first = batches.empty();
+            batches.push_back(count);
+        }
+        if (first) {
+            gate.wait();
+        }
+    }
+
+    std::promise<void> release;
+    std::shared_future<void> gate;
+    mutable std::mutex mutex;
+    mutable std::vector<size_t> batches;
+};
+
+
+class AsyncTextCryptoProviderTest : public ::testing::Test {
+public:
+    AsyncTextCryptoProviderTest() : gated(boost::make_shared<GatedTextCryptoProvider>()) {}
+    virtual ~AsyncTextCryptoProviderTest() {}
+
+    boost::shared_ptr<GatedTextCryptoProvider> gated;
+};
+
+
+TEST_F(AsyncTextCryptoProviderTest, testRoundTrip) {
+    gated->release.set_value();
+    AsyncTextCryptoProvider provider(gated, 2);
+
+    std::vector<std::future<std::string> > encrypted;
+    for (int i = 0; i < 100; ++i) {
+        encrypted.push_back(provider.encrypt("message " + boost::lexical_cast<std::string>(i)));
+    }
+
+    std::vector<std::future<std::string> > decrypted;
+    for (size_t i = 0; i < encrypted.size(); ++i) {
+        decrypted.push_back(provider.decrypt(encrypted[i].get()));
+    }
+    for (size_t i = 0; i < decrypted.size(); ++i) {
+        EXPECT_EQ("message " + boost::lexical_cast<std::string>(i), decrypted[i].get());
+    }
+}
+
+
+TEST_F(AsyncTextCryptoProviderTest, testBatchesWaitingRequests) {
+    AsyncTextCryptoProvider provider(gated, 1, 64, 8);
+
+    std::future<std::string> first = provider.encrypt("first");
+    while (true) {
+        std::lock_guard<std::mutex> lock(gated->mutex);
+        if (!gated->batches.empty()) {
+            break;
+        }
+    }
+
+    //these queue up behind the held batch, interleaved with a decrypt
+    std::vector<std::future<std::string> > results;
+    for (int i = 0; i < 10; ++i) {
+        results.push_back(provider.encrypt("queued"));
+    }
+    std::future<std::string> decrypted = provider.decrypt(gated->encrypt("decrypted"));
+    EXPECT_EQ(11U, provider.pending());
+
+    gated->release.set_value();
+    EXPECT_EQ("first", gated->decrypt(first.get()));
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ("queued", gated->decrypt(results[i].get()));
+    }
+    EXPECT_EQ("decrypted", decrypted.get());
+
+    std::lock_guard<std::mutex> lock(gated->mutex);
+    ASSERT_EQ(3U, gated->batches.size());
+    EXPECT_EQ(1U, gated->batches[0]);
+    EXPECT_EQ(8U, gated->batches[1]);
+    EXPECT_EQ(2U, gated->batches[2]);
+}
+
+
+TEST_F(AsyncTextCryptoProviderTest, testFailures) {
+    gated->release.set_value();
+    AsyncTextCryptoProvider provider(gated);
+
+    std::future<std::string> invalid = provider.decrypt("not base64!!");
+    std::future<std::string> valid = provider.decrypt(gated->encrypt("valid"));
+    EXPECT_THROW(invalid.get(), SecurityException);
+    EXPECT_EQ("valid", valid.get());
+
+    std::string result;
+    std::exception_ptr error;
+    std::promise<void> done;
+    provider.decrypt("not base64!!", [&](std::string* r, std::exception_ptr e) {
+        result = r ? *r : "";
+        error = e;
+        done.set_value();
+    });
+    done.get_future().wait();
+    EXPECT_TRUE(static_cast<bool>(error));
+}
+
+
+TEST_F(AsyncTextCryptoProviderTest, testQueueFull) {
+    AsyncTextCryptoProvider provider(gated, 1, 1);
+
+    std::future<std::string> first = provider.encrypt("first");
+    while (true) {
+        std::lock_guard<std::mutex> lock(gated->mutex);
+        if (!gated->batches.empty()) {
+            break;
+        }
+    }
+
+    std::future<std::string> queued = provider.encrypt("queued");
+    std::future<std::string> rejected = provider.encrypt("rejected");
+    EXPECT_THROW(rejected.get(), SecurityException);
+
+    gated->release.set_value();
+    EXPECT_EQ("first", gated->decrypt(first.get()));
+    EXPECT_EQ("queued", gated->decrypt(queued.get()));
+}
@@ -0,0 +1,123 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * Base64StreamTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/Base64Stream.h>
+#include <ezbake/common/security/Base64Util.h>
+#include <ezbake/common/security/PbeStringEncryptor.h>
+
+using namespace ::ezbake::common::security;
+
+
+class Base64StreamTest : public ::testing::Test {
+public:
+    Base64StreamTest() {
+        for (int i = 0; i < 10000; ++i) {
+            binary.push_back(static_cast<char>((i * 131) ^ (i >> 5)));
+        }
+    }
+    virtual ~Base64StreamTest() {}
+
+    std::string encodeInChunks(const std::string& data, size_t chunk) {
+        Base64Encoder encoder;
+        std::string out;
+        std::vector<char> buffer(Base64Encoder::maxUpdateLength(chunk));
+        for (size_t i = 0; i < data.length(); i += chunk) {
+            size_t length = std::min(chunk, data.length() - i);
+            out.append(&buffer[0], encoder.update(data.data() + i, length, &buffer[0]));
+        }
+        char last[Base64Encoder::MAX_FINISH_LENGTH];
+        out.append(last, encoder.finish(last));
+        return out;
+    }
+
+    std::string decodeInChunks(const std::string& text, size_t chunk) {
+        Base64Decoder decoder;
+        std::string out;
+        std::vector<char> buffer(Base64Decoder::maxUpdateLength(chunk));
+        for (size_t i = 0; i < text.length(); i += chunk) {
+            size_t length = std::min(chunk, text.length() - i);
+            out.append(&buffer[0], decoder.update(text.data() + i, length, &buffer[0]));
+        }
+        decoder.finish();
+        return out;
+    }
+
+    std::string binary;
+};
+
+
+TEST_F(Base64StreamTest, testChunkedMatchesOneShot) {
+    size_t chunks[] = { 1, 2, 3, 5, 64, 1000, 4096, 20000 };
+    std::string encoded = Base64Util::encode(binary);
+
+    for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i) {
+        EXPECT_EQ(encoded, encodeInChunks(binary, chunks[i]));
+        EXPECT_EQ(binary, decodeInChunks(encoded, chunks[i]));
+    }
+    EXPECT_EQ("Zm9vYg==", encodeInChunks("foob", 3));
+    EXPECT_EQ("", encodeInChunks("", 3));
+}
+
+
+TEST_F(Base64StreamTest, testScatterInput) {
+    struct iovec buffers[3];
+    buffers[0].iov_base = const_cast<char*>(binary.data());
+    buffers[0].iov_len = 7;
+    buffers[1].iov_base = const_cast<char*>(binary.data() + 7);
+    buffers[1].iov_len = 0;
+    buffers[2].iov_base = const_cast<char*>(binary.data() + 7);
+    buffers[2].iov_len = binary.length() - 7;
+
+    std::string encoded;
+    OutputSink appendEncoded = [&encoded](const char* data, size_t length) { encoded.append(data, length); };
+    Base64Encoder encoder;
+    encoder.update(buffers, 3, appendEncoded);
+    encoder.finish(appendEncoded);
+    EXPECT_EQ(Base64Util::encode(binary), encoded);
+
+    buffers[0].iov_base = const_cast<char*>(encoded.data());
+    buffers[0].iov_len = 5;
+    buffers[1].iov_base = const_cast<char*>(encoded.data() + 5);
+    buffers[1].iov_len = encoded.length() - 5;
+
+    std::string decoded;
+    Base64Decoder decoder;
+    decoder.update(buffers, 2, [&decoded](const char* data, size_t length) { decoded.append(data, length); });
+    decoder.finish();
+    EXPECT_EQ(binary, decoded);
+}
+
+
+TEST_F(Base64StreamTest, testInvalidInput) {
+    EXPECT_THROW(decodeInChunks("Zm9vYg=", 2), StringEncryptorException);
+    EXPECT_THROW(decodeInChunks("Zm9v*mFy", 2), StringEncryptorException);
+    EXPECT_THROW(decodeInChunks("Zg==Zm9v", 3), StringEncryptorException);
+
+    Base64Decoder decoder;
+    char buffer[8];
+    EXPECT_EQ(0U, decoder.update("Zm9", 3, buffer));
+    EXPECT_EQ(3U, decoder.pending());
+    EXPECT_THROW(decoder.finish(), StringEncryptorException);
+    EXPECT_EQ(0U, decoder.pending());
+    EXPECT_EQ(3U, decoder.update("Zm9v", 4, buffer));
+}
@@ -22,6 +22,7 @@
 #include "../AllTests.h"
 
 #include <ezbake/common/security/Base64Util.h>
+#include <openssl/evp.h>
 
 
 class Base64UtilTest : public ::testing::Test {
@@ -42,3 +43,159 @@ TEST_F(Base64UtilTest, EncodeDecode) {
     EXPECT_EQ(Base64Util::encode("fooba"), "Zm9vYmE=");
     EXPECT_EQ(Base64Util::encode("foobar"), "Zm9vYmFy");
 }
+
+
+TEST_F(Base64UtilTest, Decode) {
+    EXPECT_EQ(Base64Util::decode(""), "");
+    EXPECT_EQ(Base64Util::decode("Zg=="), "f");
+    EXPECT_EQ(Base64Util::decode("Zm8="), "fo");
+    EXPECT_EQ(Base64Util::decode("Zm9v"), "foo");
+    EXPECT_EQ(Base64Util::decode("Zm9vYg=="), "foob");
+    EXPECT_EQ(Base64Util::decode("Zm9vYmE="), "fooba");
+    EXPECT_EQ(Base64Util::decode("Zm9vYmFy"), "foobar");
+    EXPECT_EQ(Base64Util::decode("Zm9vYg"), "foob");
+    EXPECT_EQ(Base64Util::decode(" Zm9vYmFy\n"), "foobar");
+    EXPECT_EQ(Base64Util::decode("Zm9v*mFy"), "");
+
+    std::string binary;
+    for (int i = 0; i < 256; ++i) {
+        binary.push_back(static_cast<char>(i));
+    }
+    EXPECT_EQ(binary, Base64Util::decode(Base64Util::encode(binary)));
+}
+
+
+TEST_F(Base64UtilTest, LongInputs) {
+    //long enough for every vector kernel, checked against OpenSSL
+    std::string binary;
+    for (int i = 0; i < 700; ++i) {
+        binary.push_back(static_cast<char>((i * 131) ^ (i >> 3)));
+    }
+
+    for (size_t length = 0; length <= binary.length(); length += 7) {
+        std::string expected(4 * ((length + 2) / 3) + 1, '\0');
+        int written = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&expected[0]),
+                                      reinterpret_cast<const unsigned char*>(binary.data()), static_cast<int>(length));
+        expected.resize(written);
+
+        std::string encoded = Base64Util::encode(binary.data(), static_cast<int>(length));
+        EXPECT_EQ(expected, encoded);
+        EXPECT_EQ(binary.substr(0, length), Base64Util::decode(encoded));
+    }
+
+    std::string encoded = Base64Util::encode(binary);
+    for (size_t i = 0; i < encoded.length(); i += 37) {
+        std::string invalid = encoded;
+        invalid[i] = '*';
+        EXPECT_EQ("", Base64Util::decode(invalid));
+        invalid[i] = '\xC3';
+        EXPECT_EQ("", Base64Util::decode(invalid));
+    }
+}
+
+
+TEST_F(Base64UtilTest, CallerBuffers) {
+    EXPECT_EQ(0U, Base64Util::encodedLength(0));
+    EXPECT_EQ(4U, Base64Util::encodedLength(1));
+    EXPECT_EQ(8U, Base64Util::encodedLength(6));
+    EXPECT_EQ(3U, Base64Util::decodedMaxLength(4));
+    EXPECT_EQ(6U, Base64Util::decodedMaxLength(6));
+
+    char buffer[16];
+    EXPECT_EQ(8U, Base64Util::encodeTo("fooba", 5, buffer));
+    EXPECT_EQ("Zm9vYmE=", std::string(buffer, 8));
+
+    //in place, with the data at the end of the buffer
+    memcpy(buffer + 3, "fooba", 5);
+    EXPECT_EQ(8U, Base64Util::encodeTo(buffer + 3, 5, buffer));
+    EXPECT_EQ("Zm9vYmE=", std::string(buffer, 8));
+
+    EXPECT_EQ(5U, Base64Util::decodeInPlace(buffer, 8));
+    EXPECT_EQ("fooba", std::string(buffer, 5));
+    memcpy(buffer, " Zm9vYg\n", 8);
+    EXPECT_EQ(4U, Base64Util::decodeInPlace(buffer, 8));
+    EXPECT_EQ("foob", std::string(buffer, 4));
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeTo("Zm9v*mFy", 8, buffer));
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeTo("Zm9vY", 5, buffer));
+
+    std::string out("prefix:");
+    Base64Util::appendEncoded("foo", 3, out);
+    EXPECT_EQ("prefix:Zm9v", out);
+    EXPECT_TRUE(Base64Util::appendDecoded(std::string("YmFy"), out));
+    EXPECT_EQ("prefix:Zm9vbar", out);
+    EXPECT_FALSE(Base64Util::appendDecoded(std::string("Y*Fy"), out));
+    EXPECT_EQ("prefix:Zm9vbar", out);
+}
+
+
+TEST_F(Base64UtilTest, StrictDecode) {
+    std::string encoded = Base64Util::encode(std::string(300, 'x'));
+    std::vector<char> buffer(Base64Util::decodedMaxLength(encoded.length()));
+    size_t errorOffset = 0;
+
+    EXPECT_EQ(300U, Base64Util::decodeStrict(encoded.data(), encoded.length(), &buffer[0], errorOffset));
+    EXPECT_EQ(encoded.length(), errorOffset);
+
+    //the offset is found whether the vector kernels or the scalar tail see the character
+    size_t offsets[] = { 0, 5, 63, 64, 250, 398, 399 };
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i) {
+        std::string invalid = encoded;
+        invalid[offsets[i]] = '*';
+        EXPECT_EQ(Base64Util::npos, Base64Util::decodeStrict(invalid.data(), invalid.length(), &buffer[0], errorOffset));
+        EXPECT_EQ(offsets[i], errorOffset);
+    }
+
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeStrict("Zg==Zm9v", 8, &buffer[0], errorOffset));
+    EXPECT_EQ(4U, errorOffset);
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeStrict("Zm=v", 4, &buffer[0], errorOffset));
+    EXPECT_EQ(3U, errorOffset);
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeStrict(" Zm9v", 5, &buffer[0], errorOffset));
+    EXPECT_EQ(0U, errorOffset);
+    EXPECT_EQ(Base64Util::npos, Base64Util::decodeStrict("Zm9vYg", 6, &buffer[0], errorOffset));
+    EXPECT_EQ(6U, errorOffset);
+}
+
+
+TEST_F(Base64UtilTest, Batch) {
+    //short identifiers, with an empty item and one larger than a kernel slice
+    std::vector<std::string> data;
+    for (size_t i = 0; i < 3000; ++i) {
+        data.push_back(std::string(16 + (i * 7) % 49, static_cast<char>('a' + i % 26)));
+    }
+    data[17] = "";
+    data[2500] = std::string(20000, '\xfe');
+
+    std::vector<boost::string_ref> items(data.begin(), data.end());
+    std::vector<Base64Util::Span> spans(items.size());
+    std::string arena = "prefix";
+    Base64Util::encodeBatch(&items[0], items.size(), arena, &spans[0]);
+
+    std::vector<std::string> encoded;
+    for (size_t i = 0; i < data.size(); ++i) {
+        encoded.push_back(arena.substr(spans[i].offset, spans[i].length));
+        ASSERT_EQ(Base64Util::encode(data[i]), encoded[i]) << "item " << i;
+    }
+    EXPECT_EQ(arena.size(), spans.back().offset + spans.back().length);
+
+    //invalid items take no space, including padding before the last group
+    encoded[5][3] = '*';
+    encoded[6] = "Zg==" + encoded[6];
+    encoded[7] = encoded[7] + "Z";
+    encoded[8][encoded[8].size() - 3] = '=';
+    encoded[2500][15000] = '.';
+
+    std::vector<boost::string_ref> texts(encoded.begin(), encoded.end());
+    std::string decoded;
+    EXPECT_EQ(5U, Base64Util::decodeBatch(&texts[0], texts.size(), decoded, &spans[0]));
+
+    size_t total = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i == 5 || i == 6 || i == 7 || i == 8 || i == 2500) {
+            EXPECT_EQ(Base64Util::npos, spans[i].length) << "item " << i;
+            continue;
+        }
+        ASSERT_EQ(data[i], decoded.substr(spans[i].offset, spans[i].length)) << "item " << i;
+        total += spans[i].length;
+    }
+    EXPECT_EQ(total, decoded.size());
+}
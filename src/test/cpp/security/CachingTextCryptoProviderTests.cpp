@@ -0,0 +1,112 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CachingTextCryptoProviderTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/CachingTextCryptoProvider.h>
+#include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
+#include <boost/make_shared.hpp>
+#include <atomic>
+
+using namespace ::ezbake::common::security;
+
+
+/*
+ * Counts the decrypts that reach the real provider
+ */
+class CountingTextCryptoProvider : public SharedSecretTextCryptoProvider {
+public:
+    CountingTextCryptoProvider() : SharedSecretTextCryptoProvider("swordfish"), decrypts(0) {}
+
+    virtual size_t decryptTo(boost::string_ref encryptedMessage, char* out, size_t capacity) const {
+        ++decrypts;
+        return SharedSecretTextCryptoProvider::decryptTo(encryptedMessage, out, capacity);
+    }
+
+    mutable std::atomic<int> decrypts;
+};
+
+
+class CachingTextCryptoProviderTest : public ::testing::Test {
+public:
+    CachingTextCryptoProviderTest() : counting(boost::make_shared<CountingTextCryptoProvider>()) {}
+    virtual ~CachingTextCryptoProviderTest() {}
+
+    boost::shared_ptr<CountingTextCryptoProvider> counting;
+};
+
+
+TEST_F(CachingTextCryptoProviderTest, testMemoizesDecrypt) {
+    CachingTextCryptoProvider provider(counting);
+    std::string encrypted = provider.encrypt("My test message");
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ("My test message", provider.decrypt(encrypted));
+    }
+    EXPECT_EQ(1, counting->decrypts.load());
+
+    std::string out;
+    provider.appendDecrypted(encrypted, out);
+    EXPECT_EQ("My test message", out);
+    EXPECT_EQ(1, counting->decrypts.load());
+
+    provider.clear();
+    EXPECT_EQ("My test message", provider.decrypt(encrypted));
+    EXPECT_EQ(2, counting->decrypts.load());
+}
+
+
+TEST_F(CachingTextCryptoProviderTest, testFailuresAreNotCached) {
+    CachingTextCryptoProvider provider(counting);
+    EXPECT_THROW(provider.decrypt("not base64!!"), SecurityException);
+    EXPECT_THROW(provider.decrypt("not base64!!"), SecurityException);
+    EXPECT_EQ(2, counting->decrypts.load());
+}
+
+
+TEST_F(CachingTextCryptoProviderTest, testEviction) {
+    CachingTextCryptoProvider provider(counting, 2);
+    std::string first = provider.encrypt("first");
+    std::string second = provider.encrypt("second");
+    std::string third = provider.encrypt("third");
+
+    EXPECT_EQ("first", provider.decrypt(first));
+    EXPECT_EQ("second", provider.decrypt(second));
+    EXPECT_EQ("third", provider.decrypt(third));
+    EXPECT_EQ("third", provider.decrypt(third));
+    EXPECT_EQ(3, counting->decrypts.load());
+
+    //least recently used entry was evicted
+    EXPECT_EQ("first", provider.decrypt(first));
+    EXPECT_EQ(4, counting->decrypts.load());
+}
+
+
+TEST_F(CachingTextCryptoProviderTest, testSecureBuffer) {
+    SecureBuffer buffer(std::string("secret\0value", 12));
+    EXPECT_EQ(std::string("secret\0value", 12), buffer.str());
+    EXPECT_EQ(12U, buffer.size());
+
+    SecureBuffer empty("");
+    EXPECT_EQ(0U, empty.size());
+    EXPECT_TRUE(empty.data() != NULL);
+}
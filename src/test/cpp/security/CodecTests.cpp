@@ -0,0 +1,182 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CodecTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/Base64Util.h>
+#include <ezbake/common/security/Codec.h>
+#include <ezbake/common/security/PbeStringEncryptor.h>
+
+using namespace ::ezbake::common::security;
+
+
+class CodecTest : public ::testing::Test {
+public:
+    CodecTest() {
+        for (int i = 0; i < 10000; ++i) {
+            binary.push_back(static_cast<char>((i * 131) ^ (i >> 5)));
+        }
+        codecs.push_back(&Codec::base64());
+        codecs.push_back(&Codec::base64Url());
+        codecs.push_back(&Codec::base32());
+        codecs.push_back(&Codec::hex());
+    }
+    virtual ~CodecTest() {}
+
+    std::string decode(const Codec& codec, const std::string& text) {
+        std::string out;
+        EXPECT_TRUE(codec.appendDecoded(text, out)) << codec.name() << ": " << text;
+        return out;
+    }
+
+    std::string streamInChunks(const Codec& codec, const std::string& data, size_t chunk) {
+        Codec::Encoder encoder(codec);
+        Codec::Decoder decoder(codec);
+        std::string encoded, decoded;
+        OutputSink encodedSink = [&encoded](const char* data, size_t length) { encoded.append(data, length); };
+        OutputSink decodedSink = [&decoded](const char* data, size_t length) { decoded.append(data, length); };
+
+        for (size_t i = 0; i < data.length(); i += chunk) {
+            encoder.update(data.data() + i, std::min(chunk, data.length() - i), encodedSink);
+        }
+        encoder.finish(encodedSink);
+
+        for (size_t i = 0; i < encoded.length(); i += chunk) {
+            decoder.update(encoded.data() + i, std::min(chunk, encoded.length() - i), decodedSink);
+        }
+        decoder.finish(decodedSink);
+
+        EXPECT_EQ(codec.encode(data), encoded) << codec.name() << " chunk " << chunk;
+        return decoded;
+    }
+
+    std::string binary;
+    std::vector<const Codec*> codecs;
+};
+
+
+TEST_F(CodecTest, testKnownVectors) {
+    //RFC 4648 section 10
+    const char* vectors[][5] = {
+        { "", "", "", "", "" },
+        { "f", "Zg==", "Zg", "MY======", "66" },
+        { "fo", "Zm8=", "Zm8", "MZXQ====", "666f" },
+        { "foo", "Zm9v", "Zm9v", "MZXW6===", "666f6f" },
+        { "foob", "Zm9vYg==", "Zm9vYg", "MZXW6YQ=", "666f6f62" },
+        { "fooba", "Zm9vYmE=", "Zm9vYmE", "MZXW6YTB", "666f6f6261" },
+        { "foobar", "Zm9vYmFy", "Zm9vYmFy", "MZXW6YTBOI======", "666f6f626172" }
+    };
+
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); ++i) {
+        for (size_t c = 0; c < codecs.size(); ++c) {
+            EXPECT_EQ(vectors[i][c + 1], codecs[c]->encode(vectors[i][0]));
+            EXPECT_EQ(vectors[i][0], decode(*codecs[c], vectors[i][c + 1]));
+            EXPECT_EQ(strlen(vectors[i][c + 1]), codecs[c]->encodedLength(strlen(vectors[i][0])));
+        }
+    }
+
+    EXPECT_EQ("-_8", Codec::base64Url().encode("\xfb\xff"));
+    EXPECT_EQ("\xfb\xff", decode(Codec::base64Url(), "-_8="));
+    EXPECT_EQ("\xab\xcd", decode(Codec::hex(), "AbCd"));
+}
+
+
+TEST_F(CodecTest, testLongInputs) {
+    EXPECT_EQ(Base64Util::encode(binary), Codec::base64().encode(binary));
+
+    for (size_t c = 0; c < codecs.size(); ++c) {
+        const Codec& codec = *codecs[c];
+        for (size_t length = 0; length < 300; length += 7) {
+            std::string data = binary.substr(0, length);
+            EXPECT_EQ(data, decode(codec, codec.encode(data))) << codec.name() << " length " << length;
+        }
+
+        //decoding in place over the encoded text
+        std::string text = codec.encode(binary);
+        size_t errorOffset = 0;
+        size_t written = codec.decodeTo(text.data(), text.length(), &text[0], errorOffset);
+        ASSERT_EQ(binary.length(), written) << codec.name();
+        EXPECT_EQ(binary, text.substr(0, written));
+        EXPECT_EQ(text.length(), errorOffset);
+
+        size_t chunks[] = { 1, 3, 7, 64, 4097, 20000 };
+        for (size_t i = 0; i < sizeof(chunks) / sizeof(chunks[0]); ++i) {
+            EXPECT_EQ(binary, streamInChunks(codec, binary, chunks[i])) << codec.name() << " chunk " << chunks[i];
+        }
+    }
+}
+
+
+TEST_F(CodecTest, testInvalidInput) {
+    std::string out = "kept";
+    size_t errorOffset = 0;
+    char buffer[64];
+
+    EXPECT_EQ(Codec::npos, Codec::hex().decodeTo("00ff0g", 6, buffer, errorOffset));
+    EXPECT_EQ(5u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::hex().decodeTo("00f", 3, buffer, errorOffset));
+    EXPECT_EQ(3u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::base32().decodeTo("MZXW6YQ=MZXW6YTB", 16, buffer, errorOffset));
+    EXPECT_EQ(8u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::base32().decodeTo("MZXW1YQ=", 8, buffer, errorOffset));
+    EXPECT_EQ(4u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::base64Url().decodeTo("Zm9v+g", 6, buffer, errorOffset));
+    EXPECT_EQ(4u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::base64Url().decodeTo("Zm9vY", 5, buffer, errorOffset));
+    EXPECT_EQ(5u, errorOffset);
+    EXPECT_EQ(Codec::npos, Codec::base64().decodeTo("Zm9vYg", 6, buffer, errorOffset));
+    EXPECT_EQ(6u, errorOffset);
+
+    EXPECT_FALSE(Codec::base64().appendDecoded("Zm9v YmFy", out));
+    EXPECT_EQ("kept", out);
+
+    Codec::Decoder decoder(Codec::hex());
+    char chunk[8];
+    decoder.update("00ff", 4, chunk);
+    EXPECT_THROW(decoder.update("00zz", 4, chunk), StringEncryptorException);
+    decoder.reset();
+    decoder.update("0", 1, chunk);
+    EXPECT_EQ(1u, decoder.pending());
+    EXPECT_THROW(decoder.finish(chunk), StringEncryptorException);
+}
+
+
+TEST_F(CodecTest, testTranscode) {
+    for (size_t from = 0; from < codecs.size(); ++from) {
+        std::string text = codecs[from]->encode(binary);
+        for (size_t to = 0; to < codecs.size(); ++to) {
+            std::string out = "prefix:";
+            size_t errorOffset = 0;
+            ASSERT_TRUE(Codec::transcode(*codecs[from], *codecs[to], text.data(), text.length(), out, errorOffset));
+            EXPECT_EQ("prefix:" + codecs[to]->encode(binary), out) << codecs[from]->name() << " to " << codecs[to]->name();
+            EXPECT_EQ(text.length(), errorOffset);
+        }
+    }
+
+    //an error past the first slice is reported at its offset in the whole input
+    std::string text = Codec::hex().encode(binary);
+    text[12345] = 'x';
+    std::string out;
+    size_t errorOffset = 0;
+    EXPECT_FALSE(Codec::transcode(Codec::hex(), Codec::base64(), text.data(), text.length(), out, errorOffset));
+    EXPECT_EQ(12345u, errorOffset);
+    EXPECT_TRUE(out.empty());
+}
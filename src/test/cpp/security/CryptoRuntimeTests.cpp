@@ -0,0 +1,78 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * CryptoRuntimeTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/CryptoRuntime.h>
+#include <thread>
+
+using namespace ::ezbake::common::security;
+
+
+class CryptoRuntimeTest : public ::testing::Test {
+public:
+    CryptoRuntimeTest() {}
+    virtual ~CryptoRuntimeTest() {}
+};
+
+
+TEST_F(CryptoRuntimeTest, testAlgorithms) {
+    const CryptoRuntime& runtime = CryptoRuntime::instance();
+    EXPECT_EQ(&runtime, &CryptoRuntime::instance());
+    EXPECT_EQ(16, EVP_MD_size(runtime.md5()));
+    EXPECT_EQ(32, EVP_MD_size(runtime.sha256()));
+    EXPECT_EQ(32, EVP_CIPHER_key_length(runtime.aes256Gcm()));
+}
+
+
+TEST_F(CryptoRuntimeTest, testContextReuse) {
+    EVP_MD_CTX* first;
+    {
+        DigestContext ctx;
+        first = ctx.get();
+
+        //nested borrows must not share the context in use
+        DigestContext nested;
+        EXPECT_NE(first, nested.get());
+    }
+
+    {
+        DigestContext ctx;
+        EXPECT_EQ(first, ctx.get());
+    }
+
+    EVP_MD_CTX* other = NULL;
+    std::thread thread([&other]() {
+        DigestContext ctx;
+        other = ctx.get();
+    });
+    thread.join();
+    EXPECT_NE(first, other);
+
+    EVP_CIPHER_CTX* cipher;
+    {
+        CipherContext ctx;
+        cipher = ctx.get();
+    }
+    CipherContext ctx;
+    EXPECT_EQ(cipher, ctx.get());
+}
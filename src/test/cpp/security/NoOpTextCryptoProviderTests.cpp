@@ -48,3 +48,25 @@ TEST_F(NoOpTextCryptoProviderTest, testDecrypt) {
     boost::shared_ptr<TextCryptoProvider> provider = boost::make_shared<NoOpTextCryptoProvider>();
     EXPECT_EQ(provider->encrypt(message), provider->encrypt(message)) << "The message has changed, but should not have!";
 }
+
+
+TEST_F(NoOpTextCryptoProviderTest, testBatch) {
+    std::string messages[] = {"one", "two"};
+    std::string results[2];
+    boost::shared_ptr<TextCryptoProvider> provider = boost::make_shared<NoOpTextCryptoProvider>();
+    EXPECT_TRUE(provider->decryptBatch(messages, results, 2).empty());
+    EXPECT_EQ("one", results[0]);
+    EXPECT_EQ("two", results[1]);
+}
+
+
+TEST_F(NoOpTextCryptoProviderTest, testCallerBuffers) {
+    NoOpTextCryptoProvider provider;
+    std::string out = "a";
+    provider.appendEncrypted("bc", out);
+    provider.appendDecrypted("de", out);
+    EXPECT_EQ("abcde", out);
+
+    char small[1];
+    EXPECT_THROW(provider.encryptTo("bc", small, sizeof(small)), SecurityException);
+}
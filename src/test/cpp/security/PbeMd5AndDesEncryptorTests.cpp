@@ -23,6 +23,8 @@
 #include "../AllTests.h"
 
 #include <ezbake/common/security/PbeMd5AndDesEncryptor.h>
+#include <cstring>
+#include <vector>
 
 using namespace ::ezbake::common::security;
 
@@ -73,3 +75,94 @@ TEST_F(PbeMd5AndDesEncryptorTest, testExceptions) {
     EXPECT_THROW(PbeMd5AndDesEncryptor::decrypt("agreatstring", "alsoagreatpassword", "small", 2), std::runtime_error);
 }
 
+
+
+TEST_F(PbeMd5AndDesEncryptorTest, testPrecomputedKey) {
+    std::string plainText = "TheKingOfTheNorth";
+    std::string password = "AWonderfulPassword";
+
+    boost::shared_ptr<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey> key =
+            PbeMd5AndDesEncryptor::getKey(password, SALT, ITERTAIONS);
+
+    //derived keys are cached and reused
+    EXPECT_EQ(key, PbeMd5AndDesEncryptor::getKey(password, SALT, ITERTAIONS));
+    EXPECT_NE(key, PbeMd5AndDesEncryptor::getKey(password, SALT, ITERTAIONS + 1));
+    EXPECT_NE(key, PbeMd5AndDesEncryptor::getKey(password + "1", SALT, ITERTAIONS));
+
+    //the key is not consumed by use
+    EXPECT_EQ("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", PbeMd5AndDesEncryptor::encrypt(plainText, *key));
+    EXPECT_EQ("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", PbeMd5AndDesEncryptor::encrypt(plainText, *key));
+    EXPECT_EQ(plainText, PbeMd5AndDesEncryptor::decrypt("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", *key));
+}
+
+
+TEST_F(PbeMd5AndDesEncryptorTest, testGenerateKeys) {
+    //more than one full group of SIMD lanes plus a partial one
+    std::vector<std::string> passwords, salts;
+    for (int i = 0; i < 19; ++i) {
+        passwords.push_back(std::string(i * 7, 'p') + char('a' + i));
+        salts.push_back(i % 2 ? SALT : "AnotherSaltValue");
+    }
+
+    std::vector<PbeMd5AndDesEncryptor::PbeMd5AndDesKey> keys(passwords.size());
+    PbeMd5AndDesEncryptor::generateKeys(&passwords[0], &salts[0], passwords.size(), ITERTAIONS, &keys[0]);
+
+    for (size_t i = 0; i < passwords.size(); ++i) {
+        PbeMd5AndDesEncryptor::PbeMd5AndDesKey expected =
+                PbeMd5AndDesEncryptor::generateKey(passwords[i], salts[i], ITERTAIONS);
+        EXPECT_EQ(0, std::memcmp(&expected, &keys[i], sizeof(expected))) << "key " << i;
+    }
+
+    EXPECT_EQ("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", PbeMd5AndDesEncryptor::encrypt("TheKingOfTheNorth",
+            PbeMd5AndDesEncryptor::generateKey("AWonderfulPassword", SALT, ITERTAIONS)));
+
+    salts[5] = "short";
+    EXPECT_THROW(PbeMd5AndDesEncryptor::generateKeys(&passwords[0], &salts[0], passwords.size(), ITERTAIONS,
+            &keys[0]), StringEncryptorException);
+}
+
+
+TEST_F(PbeMd5AndDesEncryptorTest, testDecryptBatch) {
+    PbeMd5AndDesEncryptor::PbeMd5AndDesKey keys[] = {
+        PbeMd5AndDesEncryptor::generateKey("AWonderfulPassword", SALT, ITERTAIONS),
+        PbeMd5AndDesEncryptor::generateKey("alsoagreatpassword", SALT, ITERTAIONS)
+    };
+
+    std::vector<std::string> encrypted;
+    std::vector<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey*> messageKeys;
+    for (int i = 0; i < 100; ++i) {
+        encrypted.push_back(PbeMd5AndDesEncryptor::encrypt(std::string(i, char('a' + i % 26)), keys[i % 2]));
+        messageKeys.push_back(&keys[(i % 3) ? i % 2 : 1 - i % 2]);
+    }
+    encrypted[10] = "not base64!!";
+    encrypted[11] = "u+rBvJ4eClCtfuLKSopC1yq7QAfjSh";
+    encrypted[12] = "";
+    encrypted[13] = "oU+otnnF";
+
+    std::vector<std::string> results(encrypted.size(), "stale");
+    BatchErrors errors = PbeMd5AndDesEncryptor::decryptBatch(&encrypted[0], &results[0], encrypted.size(),
+                                                             &messageKeys[0]);
+
+    //every message must match the scalar path, including which ones fail
+    BatchErrors::const_iterator error = errors.begin();
+    for (size_t i = 0; i < encrypted.size(); ++i) {
+        bool failed = (error != errors.end() && error->index == i);
+        try {
+            std::string expected = PbeMd5AndDesEncryptor::decrypt(encrypted[i], *messageKeys[i]);
+            EXPECT_FALSE(failed) << "message " << i << ": " << error->message;
+            EXPECT_EQ(expected, results[i]) << "message " << i;
+        } catch (const StringEncryptorException&) {
+            EXPECT_TRUE(failed) << "message " << i;
+            EXPECT_TRUE(results[i].empty()) << "message " << i;
+        }
+        if (failed) {
+            ++error;
+        }
+    }
+    EXPECT_TRUE(error == errors.end());
+    EXPECT_GE(errors.size(), 4U);
+
+    std::string single = encrypted[0];
+    EXPECT_TRUE(PbeMd5AndDesEncryptor::decryptBatch(&single, &results[0], 1, keys[0]).empty());
+    EXPECT_EQ("", results[0]);
+}
@@ -0,0 +1,103 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * PbeMd5AndDesStreamTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/PbeMd5AndDesStream.h>
+#include <vector>
+
+using namespace ::ezbake::common::security;
+
+
+class PbeMd5AndDesStreamTest : public ::testing::Test {
+public:
+    PbeMd5AndDesStreamTest() : key(PbeMd5AndDesEncryptor::getKey("AWonderfulPassword", "EncryptionFTW", 1000)) {}
+    virtual ~PbeMd5AndDesStreamTest() {}
+
+    std::string encryptInChunks(const std::string& plaintext, size_t chunkSize) {
+        PbeMd5AndDesStreamEncryptor encryptor(*key);
+        std::vector<char> buffer(PbeMd5AndDesStreamEncryptor::maxUpdateLength(chunkSize));
+        std::string encrypted;
+
+        for (size_t offset = 0; offset < plaintext.length(); offset += chunkSize) {
+            size_t length = std::min(chunkSize, plaintext.length() - offset);
+            encrypted.append(&buffer[0], encryptor.update(plaintext.data() + offset, length, &buffer[0]));
+        }
+        encrypted.append(&buffer[0], encryptor.final(&buffer[0]));
+        return encrypted;
+    }
+
+    std::string decryptInChunks(const std::string& encrypted, size_t chunkSize) {
+        PbeMd5AndDesStreamDecryptor decryptor(*key);
+        std::string decrypted;
+        OutputSink sink = [&decrypted](const char* data, size_t length) { decrypted.append(data, length); };
+
+        for (size_t offset = 0; offset < encrypted.length(); offset += chunkSize) {
+            size_t length = std::min(chunkSize, encrypted.length() - offset);
+            decryptor.update(encrypted.data() + offset, length, sink);
+        }
+        decryptor.final(sink);
+        return decrypted;
+    }
+
+    boost::shared_ptr<const PbeMd5AndDesEncryptor::PbeMd5AndDesKey> key;
+};
+
+
+TEST_F(PbeMd5AndDesStreamTest, testChunkedMatchesOneShot) {
+    std::string plaintext;
+    for (int i = 0; i < 5000; ++i) {
+        plaintext.push_back(static_cast<char>(i * 31));
+    }
+
+    std::string expected = PbeMd5AndDesEncryptor::encrypt(plaintext, *key);
+    size_t chunkSizes[] = {1, 2, 3, 7, 8, 9, 24, 100, 1536, 1537, 4096, 100000};
+    for (size_t i = 0; i < sizeof(chunkSizes) / sizeof(chunkSizes[0]); ++i) {
+        EXPECT_EQ(expected, encryptInChunks(plaintext, chunkSizes[i])) << "chunk size " << chunkSizes[i];
+        EXPECT_EQ(plaintext, decryptInChunks(expected, chunkSizes[i])) << "chunk size " << chunkSizes[i];
+    }
+
+    EXPECT_EQ("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", encryptInChunks("TheKingOfTheNorth", 5));
+    EXPECT_EQ("TheKingOfTheNorth", decryptInChunks("u+rBvJ4eClCtfuLKSopC1yq7QAfjShdG", 5));
+    EXPECT_EQ("", decryptInChunks(encryptInChunks("", 5), 5));
+}
+
+
+TEST_F(PbeMd5AndDesStreamTest, testLargePayload) {
+    //larger than any thread stack
+    std::string plaintext(16 * 1024 * 1024, 'x');
+    EXPECT_EQ(plaintext, PbeMd5AndDesEncryptor::decrypt(PbeMd5AndDesEncryptor::encrypt(plaintext, *key), *key));
+}
+
+
+TEST_F(PbeMd5AndDesStreamTest, testInvalidInput) {
+    EXPECT_THROW(decryptInChunks("", 4), StringEncryptorException);
+    EXPECT_THROW(decryptInChunks("u+rBvJ4eClCtfuLKSopC1yq7QAfjSh", 4), StringEncryptorException);
+    EXPECT_THROW(decryptInChunks("u+rBvJ4eClCtfuLK", 4), StringEncryptorException);
+    EXPECT_THROW(decryptInChunks("u+rBvJ4e*lCtfuLKSopC1yq7QAfjShdG", 4), StringEncryptorException);
+    EXPECT_THROW(decryptInChunks("oU+otnnF+D/z0IJbF1/fGw==oU+o", 4), StringEncryptorException);
+
+    PbeMd5AndDesStreamEncryptor encryptor(*key);
+    char buffer[PbeMd5AndDesStreamEncryptor::MAX_FINAL_LENGTH];
+    encryptor.final(buffer);
+    EXPECT_THROW(encryptor.final(buffer), StringEncryptorException);
+}
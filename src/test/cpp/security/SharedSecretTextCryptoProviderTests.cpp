@@ -25,6 +25,8 @@
 
 #include <ezbake/common/security/SharedSecretTextCryptoProvider.h>
 #include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
+#include <vector>
 
 using namespace ::ezbake::common::security;
 
@@ -41,3 +43,87 @@ TEST_F(SharedSecretTextCryptoProviderTest, testEncryptDecrypt) {
     boost::shared_ptr<TextCryptoProvider> provider = boost::make_shared<SharedSecretTextCryptoProvider>("swordfish");
     EXPECT_EQ(plainText, provider->decrypt(provider->encrypt(plainText))) << "The decrypted text does not match the plain text!";
 }
+
+
+TEST_F(SharedSecretTextCryptoProviderTest, testBatch) {
+    ::ezbake::common::utils::ThreadPool pool(3);
+    SharedSecretTextCryptoProvider provider("swordfish", pool);
+
+    std::vector<std::string> plainTexts;
+    for (int i = 0; i < 2000; ++i) {
+        plainTexts.push_back("message " + boost::lexical_cast<std::string>(i));
+    }
+
+    std::vector<std::string> encrypted(plainTexts.size());
+    EXPECT_TRUE(provider.encryptBatch(&plainTexts[0], &encrypted[0], plainTexts.size()).empty());
+    EXPECT_EQ(provider.encrypt(plainTexts[1234]), encrypted[1234]);
+
+    //corrupt a few items, the rest of the batch must still decrypt
+    encrypted[3] = "not base64!";
+    encrypted[1999] = "u+rBvJ4eClCt";
+    encrypted[700] = encrypted[700].substr(0, 12);
+
+    std::vector<std::string> decrypted(encrypted.size(), "stale");
+    BatchErrors errors = provider.decryptBatch(&encrypted[0], &decrypted[0], encrypted.size());
+    ASSERT_EQ(3U, errors.size());
+    EXPECT_EQ(3U, errors[0].index);
+    EXPECT_EQ(700U, errors[1].index);
+    EXPECT_EQ(1999U, errors[2].index);
+    EXPECT_EQ(0U, errors[0].message.find("Error in decrypting string: "));
+
+    for (size_t i = 0; i < decrypted.size(); ++i) {
+        if (i == 3 || i == 700 || i == 1999) {
+            EXPECT_TRUE(decrypted[i].empty());
+        } else {
+            EXPECT_EQ(plainTexts[i], decrypted[i]);
+        }
+    }
+}
+
+
+TEST_F(SharedSecretTextCryptoProviderTest, testSmallBatch) {
+    //a batch of a single chunk runs on the calling thread
+    SharedSecretTextCryptoProvider provider("swordfish");
+
+    std::string encrypted[2] = { provider.encrypt("first"), "not base64!" };
+    std::string decrypted[2];
+    BatchErrors errors = provider.decryptBatch(encrypted, decrypted, 2);
+    ASSERT_EQ(1U, errors.size());
+    EXPECT_EQ(1U, errors[0].index);
+    EXPECT_EQ(0U, errors[0].message.find("Error in decrypting string: "));
+    EXPECT_EQ("first", decrypted[0]);
+}
+
+
+
+TEST_F(SharedSecretTextCryptoProviderTest, testCallerBuffers) {
+    SharedSecretTextCryptoProvider provider("swordfish");
+
+    for (size_t length = 0; length < 40; ++length) {
+        std::string plainText(length, static_cast<char>('A' + length));
+        std::string expected = provider.encrypt(plainText);
+        EXPECT_EQ(expected.length(), provider.maxEncryptedSize(length));
+
+        std::vector<char> buffer(provider.maxEncryptedSize(length));
+        size_t written = provider.encryptTo(plainText, &buffer[0], buffer.size());
+        EXPECT_EQ(expected, std::string(&buffer[0], written));
+
+        std::vector<char> decrypted(provider.maxDecryptedSize(written) + 1);
+        size_t decryptedLength = provider.decryptTo(boost::string_ref(&buffer[0], written),
+                                                    &decrypted[0], decrypted.size());
+        EXPECT_EQ(plainText, std::string(&decrypted[0], decryptedLength));
+    }
+
+    std::string out = "prefix:";
+    provider.appendEncrypted("My test message", out);
+    EXPECT_EQ("prefix:" + provider.encrypt("My test message"), out);
+
+    std::string decrypted = "prefix:";
+    provider.appendDecrypted(boost::string_ref(out).substr(7), decrypted);
+    EXPECT_EQ("prefix:My test message", decrypted);
+
+    char small[8];
+    EXPECT_THROW(provider.encryptTo("My test message", small, sizeof(small)), SecurityException);
+    EXPECT_THROW(provider.appendDecrypted("not base64!!", decrypted), SecurityException);
+    EXPECT_EQ("prefix:My test message", decrypted);
+}
@@ -0,0 +1,97 @@
+/*   Copyright (C) 2013-2014 Computer Sciences Corporation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License. */
+
+/*
+ * TextCryptoProviderTests.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: ezbake
+ */
+
+
+#include "../AllTests.h"
+
+#include <ezbake/common/security/TextCryptoProvider.h>
+#include <ezbake/common/security/CachingTextCryptoProvider.h>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+
+using namespace ::ezbake::common::security;
+
+
+/*
+ * A provider written against the original interface, implementing only
+ * encrypt and decrypt
+ */
+class ReversingTextCryptoProvider : public TextCryptoProvider {
+public:
+    virtual std::string encrypt(const std::string& message) const {
+        return std::string(message.rbegin(), message.rend()) + "!";
+    }
+
+    virtual std::string decrypt(const std::string& encryptedMessage) const {
+        if (encryptedMessage.empty() || encryptedMessage[encryptedMessage.size() - 1] != '!') {
+            BOOST_THROW_EXCEPTION(SecurityException("Not encrypted"));
+        }
+        return std::string(encryptedMessage.rbegin() + 1, encryptedMessage.rend());
+    }
+};
+
+
+class TextCryptoProviderTest : public ::testing::Test {
+public:
+    TextCryptoProviderTest() {}
+    virtual ~TextCryptoProviderTest() {}
+};
+
+
+TEST_F(TextCryptoProviderTest, testDefaultCallerBuffers) {
+    ReversingTextCryptoProvider provider;
+    EXPECT_TRUE(TextCryptoProvider::UNKNOWN_SIZE == provider.maxEncryptedSize(3));
+    EXPECT_TRUE(TextCryptoProvider::UNKNOWN_SIZE == provider.maxDecryptedSize(4));
+
+    char buffer[8];
+    size_t written = provider.encryptTo("abc", buffer, sizeof(buffer));
+    EXPECT_EQ("cba!", std::string(buffer, written));
+    written = provider.decryptTo(boost::string_ref(buffer, written), buffer, sizeof(buffer));
+    EXPECT_EQ("abc", std::string(buffer, written));
+
+    char small[3];
+    EXPECT_THROW(provider.encryptTo("abc", small, sizeof(small)), SecurityException);
+    EXPECT_THROW(provider.decryptTo("abc", buffer, sizeof(buffer)), SecurityException);
+}
+
+
+TEST_F(TextCryptoProviderTest, testDefaultAppend) {
+    ReversingTextCryptoProvider provider;
+    std::string out = "x";
+    provider.appendEncrypted("abc", out);
+    EXPECT_EQ("xcba!", out);
+
+    provider.appendDecrypted("fed!", out);
+    EXPECT_EQ("xcba!def", out);
+
+    EXPECT_THROW(provider.appendDecrypted("abc", out), SecurityException);
+    EXPECT_EQ("xcba!def", out);
+}
+
+
+TEST_F(TextCryptoProviderTest, testCachingWithoutSizeBound) {
+    CachingTextCryptoProvider provider(boost::make_shared<ReversingTextCryptoProvider>());
+    EXPECT_EQ("abc", provider.decrypt("cba!"));
+
+    char buffer[3];
+    size_t written = provider.decryptTo("cba!", buffer, sizeof(buffer));
+    EXPECT_EQ("abc", std::string(buffer, written));
+}